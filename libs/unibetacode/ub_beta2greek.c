@@ -29,18 +29,155 @@
 
 
 /*
-   Uncomment only one of the following two defines.
-   The first one uses glyphs with tonos from
-   U+0370..Y_0377.  The second uses all glyphs
-   with oxia (tonos) from U+1F00..U+1FFF.  The
-   Unicode Standard recommends using the first
-   choice, but if a font was drawn with letters
-   noticeably shaped differently from each other
-   then the second choice could be visually
-   more appealing.
+   Two tables of pre-formed letters are available.  UB_GREEK_ACCENTS_TONOS
+   uses glyphs with tonos from U+0370..U+03FF (beta2combining);
+   UB_GREEK_ACCENTS_OXIA uses all glyphs with oxia (tonos) from
+   U+1F00..U+1FFF (beta2combining_alt).  The Unicode Standard recommends
+   using the first choice, but if a font was drawn with letters noticeably
+   shaped differently from each other then the second choice could be
+   visually more appealing.
+
+   The converters only differ in which table they index, so the caller's
+   choice is turned into a table pointer once per call and handed down;
+   the per-character code is the same for both.  ub_beta2greek itself
+   keeps using UB_GREEK_ACCENTS_DEFAULT.
 */
-// #define GREEK_COMBINING beta2combining
-#define GREEK_COMBINING beta2combining_alt
+#define UB_GREEK_ACCENTS_DEFAULT UB_GREEK_ACCENTS_OXIA
+
+typedef unsigned ub_combining_row [16];  /* one row of beta2combining */
+
+static ub_combining_row *
+ub_greek_combining (int accents) {
+   return accents == UB_GREEK_ACCENTS_TONOS ? beta2combining : beta2combining_alt;
+}
+
+static int ub_greek_step (const char *beta_string, int max_beta_string,
+                          char *utf8_string, int max_utf8_string,
+                          int *quote_state, int *utf8_length,
+                          ub_combining_row *combining);
+
+
+/*
+   Fetch byte i of the Beta Code string being scanned, masked to 7 bits.
+   The input need not be null-terminated: anything at or beyond
+   max_beta_string reads as the terminator, so a caller can pass a
+   (pointer, length) pair straight through without copying.
+*/
+#define UB_BETA_AT(i) ((i) < max_beta_string ? beta_string [i] & 0x7F : '\0')
+
+
+/*
+   ASCII letter tests and case changes.  Beta Code is 7-bit, so these
+   give what <ctype.h> does in the C locale, without its per-byte
+   locale lookup, which dominated the per-letter cost.
+*/
+#define UB_ISALPHA(c) ((unsigned) (((c) | 0x20) - 'a') < 26)
+#define UB_ISUPPER(c) ((unsigned) ((c) - 'A') < 26)
+#define UB_TOLOWER(c) (UB_ISUPPER (c) ? (c) | 0x20 : (c))
+#define UB_TOUPPER(c) ((unsigned) ((c) - 'a') < 26 ? (c) & ~0x20 : (c))
+
+
+#ifndef UB_SCALAR_ONLY
+/*
+   ub_greek_quick_step - the two characters that break up plain runs
+                         most often, done without the general scanner:
+                         a vowel or rho with combining marks that has
+                         one pre-formed code point, and a sigma not
+                         spelled out as s1/s2/s3.  The output is what
+                         ub_greek_step would write.
+
+   Return value: Beta Code bytes consumed, 0 to leave the character to
+   ub_greek_step.
+*/
+static int
+ub_greek_quick_step (const char *beta_string, int max_beta_string,
+                     char *utf8_string, int *utf8_length,
+                     ub_combining_row *combining) {
+
+   int      scan_length;      /* bytes consumed so far                 */
+   int      letter;           /* column in the combining table         */
+   int      nextchar;         /* byte after the letter                 */
+   unsigned combining_marks;  /* logic OR of the marks after the letter */
+   unsigned code_point;       /* Unicode code point to write            */
+
+   unsigned ub_greek_comb2flag (unsigned code_point);
+   int ub_codept2utf8 (unsigned codept, char *utf8_bytes);
+
+
+   switch (UB_BETA_AT (0) | 0x20) {  /* the scanner lowercases letters without '*' */
+      case 'a': letter =  8; break;
+      case 'e': letter =  9; break;
+      case 'h': letter = 10; break;
+      case 'i': letter = 11; break;
+      case 'o': letter = 12; break;
+      case 'r': letter = 13; break;
+      case 'u': letter = 14; break;
+      case 'w': letter = 15; break;
+      case 's':
+         nextchar = UB_BETA_AT (1);
+         if (nextchar == '1' || nextchar == '2' || nextchar == '3')
+            return 0;
+         code_point = nextchar == '\'' || UB_ISALPHA (nextchar) ? 0x03C3 : 0x03C2;
+         *utf8_length = ub_codept2utf8 (code_point, utf8_string);
+         return 1;
+      default:
+         return 0;
+   }
+
+   combining_marks = 0;
+   for (scan_length = 1; greek_comb2uni [UB_BETA_AT (scan_length)] != 0; scan_length++)
+      combining_marks |= ub_greek_comb2flag (greek_comb2uni [UB_BETA_AT (scan_length)]);
+
+   code_point = combining [combining_marks & 0x7F] [letter];
+   if (combining_marks == 0 || code_point == 0)
+      return 0;
+   *utf8_length = ub_codept2utf8 (code_point, utf8_string);
+   return scan_length;
+}
+#endif
+
+
+/*
+   ub_greek_plain2utf8 - output a run found by ub_beta_plain_span:
+                         Latin letters become lowercase Greek letters
+                         (all in U+0391..U+03FF, so 2 bytes each) and
+                         everything else is copied as is.
+
+   Inputs:
+
+        beta_string        Start of the run.
+
+        length             Number of bytes in the run.
+
+   Outputs:
+
+        utf8_string        UTF-8 conversion of the run, not null-terminated.
+
+   Return value: the number of bytes written.
+*/
+static int
+ub_greek_plain2utf8 (const char *beta_string, int length, char *utf8_string) {
+
+   int      i;             /* loop variable             */
+   int      outposition;   /* bytes written so far      */
+   unsigned code_point;    /* Greek letter code point   */
+   char     thischar;      /* current Beta Code byte    */
+
+   outposition = 0;
+   for (i = 0; i < length; i++) {
+      thischar = beta_string [i];
+      if (UB_ISALPHA (thischar)) {
+         code_point = ascii2greek [thischar | 0x20];
+         utf8_string [outposition++] = 0xC0 | ((code_point >> 6) & 0x1F);
+         utf8_string [outposition++] = 0x80 | ( code_point       & 0x3F);
+      }
+      else {
+         utf8_string [outposition++] = thischar;
+      }
+   }
+
+   return outposition;
+}
 
 
 /*
@@ -48,7 +185,8 @@
 
    Inputs:
 
-        beta_string        Greek Beta Code string, null-terminated.
+        beta_string        Greek Beta Code string, null-terminated
+                           or exactly max_beta_string bytes long.
 
         max_beta_string    beta_string array size.
 
@@ -57,39 +195,76 @@
         utf8_string        UTF-8 conversion of Beta Code string,
                            null-terminated.
 
-        max_utf8_string    utf8_string array size.
+        max_utf8_string    utf8_string array size.  No Beta Code byte
+                           expands to more than 3 bytes of UTF-8, so
+                           3 * max_beta_string + 1 bytes always suffice.
 
    Return value: the number of bytes in the output string.
 */
 int
-ub_beta2greek (char *beta_string, int max_beta_string,
+ub_beta2greek (const char *beta_string, int max_beta_string,
                char *utf8_string, int max_utf8_string)
+{
+   int  quote_state;     /* = 1 if within a set of double quotes, = 0 if not */
+
+   int ub_beta2greek_r (const char *beta_string, int max_beta_string,
+                        char *utf8_string, int max_utf8_string,
+                        int *quote_state, int accents);
+
+
+   quote_state = 0;  /* not within a double quote pair in this string */
+
+   return ub_beta2greek_r (beta_string, max_beta_string,
+                           utf8_string, max_utf8_string, &quote_state,
+                           UB_GREEK_ACCENTS_DEFAULT);
+}
+
+
+/*
+   ub_beta2greek_r - convert a Greek Beta Code string to UTF-8, carrying
+                     the double quote state in from and out to the caller,
+                     so that a long text can be converted piece by piece,
+                     with the accented letters of the caller's choice.
+
+   Inputs:
+
+        beta_string        Greek Beta Code string, null-terminated
+                           or exactly max_beta_string bytes long.
+
+        max_beta_string    beta_string array size.
+
+        quote_state        = 1 if a Greek double quote is open before
+                           beta_string, = 0 if not; updated to the state
+                           at the end of the converted string.
+
+        accents            UB_GREEK_ACCENTS_OXIA or UB_GREEK_ACCENTS_TONOS.
+
+   Outputs:
+
+        utf8_string        UTF-8 conversion of Beta Code string,
+                           null-terminated.
+
+        max_utf8_string    utf8_string array size, as for ub_beta2greek.
+
+   Return value: the number of bytes in the output string.
+*/
+int
+ub_beta2greek_r (const char *beta_string, int max_beta_string,
+                 char *utf8_string, int max_utf8_string,
+                 int *quote_state, int accents)
 {
    int  inposition;      /* start of scan for current output, including combining marks */
    int  outposition;     /* start of current output letter plus combining marks      */
-   int  utf8length;      /* return value from UTF-8 conversion                       */
-   char thischar;        /* current character being converted                        */
-   char thisletter;      /* Latin letter with a Beta Code translation                */
-   char beta_char[4];    /* The letter portion of the current polytonic letter       */
-   char utf8_bytes[6];   /* string to hold one UTF-8 character                       */
    int  scan_length;     /* length of current Beta Code polytonic character          */
-   unsigned combining_marks;  /* logic OR of various Greek polytonic combining marks */
-   int  quote_state;     /* = 1 if within a set of double quotes, = 0 if not         */
    int  utf8_length;     /* length of last UTF-8 string built from last character    */
+   ub_combining_row *combining;  /* pre-formed letters for this call                 */
 
-   /* Return the next Greek Beta Code character */
-   int ub_greek_scanchar (char *beta_string, int max_beta_string,
-                          char *beta_char, unsigned *combining_marks);
-
-   /* Convert a Greek Beta Code string to UTF-8 */
-   int ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
-                           char *utf8_string, int max_utf8_string);
+   /* Length of the run of letters without diacritics at the current position */
+   int ub_beta_plain_span (const char *beta_string, int max_beta_string);
 
-   /* Output one UTF-8 code point, for special cases */
-   int ub_codept2utf8 (unsigned codept, char *utf8_bytes);
 
 
-   quote_state = 0;                /* not within a double quote pair in this string */
+   combining   = ub_greek_combining (accents);
    utf8_length = 0;                /* no UTF-8 output string generated yet          */
    inposition  = outposition = 0;  /* at start of input & output strings            */
 
@@ -97,26 +272,47 @@ ub_beta2greek (char *beta_string, int max_beta_string,
           beta_string [inposition] != '\0' && 
           outposition < max_utf8_string) {
 
-      scan_length = ub_greek_scanchar (&beta_string [inposition], max_beta_string,
-                                    beta_char,  &combining_marks);
-
-      if (beta_char [0] == '"') {
-         if (quote_state == 0) {  /* open Greek double quote */
-            quote_state = 1;
-            scan_length = 1;
-            utf8_length = ub_codept2utf8 (0xAB, &utf8_string [outposition]);
-         }
-         else {  /* close Greek double quote */
-            quote_state = 0;
-            scan_length = 1;
-            utf8_length = ub_codept2utf8 (0xBB, &utf8_string [outposition]);
-         }
+#ifndef UB_SCALAR_ONLY
+      /*
+         Bulk path: letters without diacritics and pass-through bytes
+         map one to one, so skip the scanner for the whole run.  Each
+         byte yields at most 2 bytes of UTF-8.  A run only stops at a
+         character the scanner has to see, so that character is
+         converted straight after it rather than going round the loop
+         to look for another run first.
+      */
+      scan_length = ub_beta_plain_span (&beta_string [inposition],
+                                        max_beta_string - inposition);
+      if (scan_length > (max_utf8_string - outposition - 1) / 2)
+         scan_length = (max_utf8_string - outposition - 1) / 2;
+      if (scan_length > 0) {
+         outposition += ub_greek_plain2utf8 (&beta_string [inposition], scan_length,
+                                             &utf8_string [outposition]);
+         inposition  += scan_length;
+         utf8_string [outposition] = '\0';
+         if (inposition >= max_beta_string     ||
+             beta_string [inposition] == '\0' ||
+             outposition >= max_utf8_string)
+            break;
       }
-      else {
-         utf8_length = ub_greek_char2utf8 (beta_char, combining_marks,
-                                           &utf8_string [outposition],
-                                           max_utf8_string - outposition);
+
+      scan_length = ub_greek_quick_step (&beta_string [inposition],
+                                         max_beta_string - inposition,
+                                         &utf8_string [outposition],
+                                         &utf8_length, combining);
+      if (scan_length > 0) {
+         inposition  += scan_length;
+         outposition += utf8_length;
+         utf8_string [outposition] = '\0';
+         continue;
       }
+#endif
+
+      scan_length = ub_greek_step (&beta_string [inposition],
+                                   max_beta_string - inposition,
+                                   &utf8_string [outposition],
+                                   max_utf8_string - outposition,
+                                   quote_state, &utf8_length, combining);
 
       inposition  += scan_length;
       outposition += utf8_length;
@@ -127,6 +323,98 @@ ub_beta2greek (char *beta_string, int max_beta_string,
 }
 
 
+/*
+   ub_beta2greek_step - convert the one polytonic Beta Code character at
+                        the start of beta_string.  Calling this in a loop
+                        gives the same output as ub_beta2greek, and lets a
+                        caller record where each character starts in both
+                        strings so it can later resume from there.
+
+   Inputs:
+
+        beta_string        Greek Beta Code string, null-terminated
+                           or exactly max_beta_string bytes long.
+
+        max_beta_string    bytes remaining in beta_string.
+
+        quote_state        = 1 if within a set of double quotes, = 0 if not;
+                           updated when a double quote is converted.
+
+        accents            UB_GREEK_ACCENTS_OXIA or UB_GREEK_ACCENTS_TONOS.
+
+   Outputs:
+
+        utf8_string        UTF-8 conversion of the character; at least 17
+                           bytes must be available (a letter with every
+                           combining mark spelled out).
+
+        utf8_length        number of bytes written to utf8_string.
+
+   Return value: number of Beta Code bytes consumed.
+*/
+int
+ub_beta2greek_step (const char *beta_string, int max_beta_string,
+                    char *utf8_string, int max_utf8_string,
+                    int *quote_state, int *utf8_length, int accents) {
+
+   return ub_greek_step (beta_string, max_beta_string,
+                         utf8_string, max_utf8_string,
+                         quote_state, utf8_length,
+                         ub_greek_combining (accents));
+}
+
+
+/*
+   ub_greek_step - ub_beta2greek_step with the table of pre-formed
+                   letters already chosen.
+*/
+static int
+ub_greek_step (const char *beta_string, int max_beta_string,
+               char *utf8_string, int max_utf8_string,
+               int *quote_state, int *utf8_length,
+               ub_combining_row *combining) {
+
+   char beta_char[4];         /* The letter portion of the current polytonic letter */
+   int  scan_length;          /* length of current Beta Code polytonic character    */
+   unsigned combining_marks;  /* logic OR of various Greek polytonic combining marks */
+
+   int ub_greek_scanchar (const char *beta_string, int max_beta_string,
+                          char *beta_char, unsigned *combining_marks);
+
+   int ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
+                           char *utf8_string, int max_utf8_string,
+                           ub_combining_row *combining);
+
+   int ub_codept2utf8 (unsigned codept, char *utf8_bytes);
+
+
+   scan_length = ub_greek_scanchar (beta_string, max_beta_string,
+                                    beta_char,  &combining_marks);
+
+   if (beta_char [0] == '"') {
+      scan_length = 1;
+      if (*quote_state == 0) {  /* open Greek double quote */
+         *quote_state = 1;
+         *utf8_length = ub_codept2utf8 (0xAB, utf8_string);
+      }
+      else {  /* close Greek double quote */
+         *quote_state = 0;
+         *utf8_length = ub_codept2utf8 (0xBB, utf8_string);
+      }
+   }
+   else {
+      *utf8_length = ub_greek_char2utf8 (beta_char, combining_marks,
+                                         utf8_string, max_utf8_string,
+                                         combining);
+      /* Nothing to print (e.g., a dangling '*'); don't embed a null */
+      if (*utf8_length == 1 && utf8_string [0] == '\0')
+         *utf8_length = 0;
+   }
+
+   return scan_length;
+}
+
+
 /*
     ub_greek_scanchar - given the current character's Beta Code starting byte
                         (i.e., beta_string[0]), find the last byte for this
@@ -134,9 +422,11 @@ ub_beta2greek (char *beta_string, int max_beta_string,
 
    Inputs:
 
-        beta_string        Greek Beta Code string, null-terminated.
+        beta_string        Greek Beta Code string, null-terminated
+                           or exactly max_beta_string bytes long.
 
-        max_beta_string    beta_string array size.
+        max_beta_string    bytes remaining in beta_string; lookahead
+                           never reads past this.
 
    Outputs:
 
@@ -148,7 +438,7 @@ ub_beta2greek (char *beta_string, int max_beta_string,
    Return value: the number of bytes in the output string.
 */
 int
-ub_greek_scanchar (char *beta_string, int max_beta_string,
+ub_greek_scanchar (const char *beta_string, int max_beta_string,
                    char *beta_char, unsigned *combining_marks) {
 
    int  outposition;     /* start of current output letter without combining marks   */
@@ -164,35 +454,35 @@ ub_greek_scanchar (char *beta_string, int max_beta_string,
    scan_length = 0;
    *combining_marks = 0;
 
-   thischar = beta_string [0] & 0x7F;
+   thischar = UB_BETA_AT (0);
 
    if (thischar == '*') {  /* Next letter is a capital letter */
       scan_length++;
       do {
-         thischar = beta_string [scan_length] & 0x7F;
+         thischar = UB_BETA_AT (scan_length);
          if (greek_comb2uni [thischar] > 0) {
             *combining_marks |= ub_greek_comb2flag (greek_comb2uni [thischar]);
             scan_length++;
          }
       }  while (greek_comb2uni [thischar] != 0);
 
-      thischar = beta_string [scan_length] & 0x7F;
-      if (isalpha (thischar)) {
-         beta_char [outposition++] = toupper (thischar);
+      thischar = UB_BETA_AT (scan_length);
+      if (UB_ISALPHA (thischar)) {
+         beta_char [outposition++] = UB_TOUPPER (thischar);
          scan_length++;
-         thischar = beta_string [scan_length] & 0x7F;
+         thischar = UB_BETA_AT (scan_length);
          if (thischar == '|') {
             *combining_marks |= ub_greek_comb2flag (greek_comb2uni [thischar]);
             scan_length++;
          }
       }
    }
-   else if (isalpha (thischar)) {  /* lowercase letter */
-      beta_char [outposition++] = tolower (thischar);
+   else if (UB_ISALPHA (thischar)) {  /* lowercase letter */
+      beta_char [outposition++] = UB_TOLOWER (thischar);
       scan_length++;
       if (thischar == 'S' || thischar == 's') {
 
-         thischar = beta_string [1] & 0x7F;
+         thischar = UB_BETA_AT (1);
          /* Special cases for sigma: s1, s2, s3 */
          if (thischar == '1' || thischar == '2' || thischar == '3') {
             beta_char [outposition++] = thischar;
@@ -203,7 +493,7 @@ ub_greek_scanchar (char *beta_string, int max_beta_string,
             beta_char [outposition++] = '1';  /* to force to medial sigma */
          }
          else {  /* look ahead one position to see if end of word */
-            if (isalpha (thischar))
+            if (UB_ISALPHA (thischar))
                beta_char [outposition++] = '1';  /* to force to medial sigma */
             else
                beta_char [outposition++] = '2';  /* to force to final sigma */
@@ -212,7 +502,7 @@ ub_greek_scanchar (char *beta_string, int max_beta_string,
       }  /* capital or small sigma */
       else {
          do {
-            thischar = beta_string [scan_length] & 0x7F;
+            thischar = UB_BETA_AT (scan_length);
             if (greek_comb2uni [thischar] > 0) {
                *combining_marks |= ub_greek_comb2flag (greek_comb2uni [thischar]);
                scan_length++;
@@ -292,11 +582,14 @@ ub_greek_comb2flag (unsigned code_point) {
 
         max_utf8_string    utf8_string array size.
 
+        combining          beta2combining or beta2combining_alt.
+
    Return value: the number of bytes in the output string.
 */
 int
 ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
-                    char *utf8_string, int max_utf8_string) {
+                    char *utf8_string, int max_utf8_string,
+                    ub_combining_row *combining) {
 
    int  i;                  /* loop variable                    */
    char thischar;           /* current letter under examination */
@@ -306,7 +599,8 @@ ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
 
    /* Turn polytonic Beta Code letter into Extended Greek code point */
    int ub_greek_poly2utf8 (char *beta_char, unsigned combining_marks,
-                           char *utf8_string, int max_utf8_string);
+                           char *utf8_string, int max_utf8_string,
+                           ub_combining_row *combining);
 
    int ub_codept2utf8 (unsigned codept, char *utf8_string);
 
@@ -321,7 +615,7 @@ ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
    */
    if (combining_marks == 0) {
       /* Handle special cases for sigma first */
-      if (tolower (thischar) == 's') {
+      if (UB_TOLOWER (thischar) == 's') {
          if (thischar == 's') {
             if (beta_char [1] == '1') {
                code_point = 0x03C3;  /* "s1" --> small medial sigma */
@@ -353,7 +647,8 @@ ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
    else {  /* Not sigma, so there's a 1-to-1 mapping from Beta Code to UTF-8 */
       utf8_length = ub_greek_poly2utf8 (
                        beta_char,   combining_marks,
-                       utf8_string, max_utf8_string);
+                       utf8_string, max_utf8_string,
+                       combining);
       if (utf8_length == 0) {
          /*
             No pre-formed code point existed for this polytonic sequence.
@@ -380,7 +675,7 @@ ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
                utf8_length += ub_codept2utf8 (0x308, &utf8_string [utf8_length]);
             }
             if (combining_marks & UB_GREEK_DIALYTIKA) {     /* 0x02 diaresis          */
-               if (isupper (beta_char [0]))   /* Uppercase letter; use prosgegrammeni */
+               if (UB_ISUPPER (beta_char [0]))   /* Uppercase letter; use prosgegrammeni */
                   utf8_length += ub_codept2utf8 (0x1FBE, &utf8_string [utf8_length]);
                else  /* Not uppercase letter; use ypogegrammeni */
                   utf8_length += ub_codept2utf8 (0x0345, &utf8_string [utf8_length]);
@@ -416,16 +711,19 @@ ub_greek_char2utf8 (char *beta_char, unsigned combining_marks,
 
         max_utf8_string    utf8_string array size.
 
+        combining          beta2combining or beta2combining_alt.
+
    Return value: length of UTF-8 string written.
 */
 int
 ub_greek_poly2utf8 (char *beta_char, unsigned combining_marks,
-                    char *utf8_string, int max_utf8_string) {
+                    char *utf8_string, int max_utf8_string,
+                    ub_combining_row *combining) {
 
    int  i;                  /* loop variable                    */
    char thischar;           /* current letter under examination */
    char nextchar;           /* to check for s1, s2, or s3       */
-   int  combining_letter;   /* column in GREEK_COMBINING array  */
+   int  combining_letter;   /* column in combining array        */
    unsigned code_point;     /* Unicode code point               */
    int  next_length;        /* next length of UTF-8 output      */
    int  utf8_length;        /* length of UTF-8 string written   */
@@ -478,7 +776,7 @@ ub_greek_poly2utf8 (char *beta_char, unsigned combining_marks,
    }
 
    if (combining_letter >= 0) {
-      code_point = GREEK_COMBINING [combining_marks] [combining_letter];
+      code_point = combining [combining_marks] [combining_letter];
       if (code_point != 0) {
          utf8_length = ub_codept2utf8 (code_point, utf8_string);
       }
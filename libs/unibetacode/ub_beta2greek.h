@@ -22,6 +22,22 @@
 */
 
 
+/*
+   Compiled as C++, the tables below are constexpr (and therefore
+   local to each translation unit that includes this file), so C++
+   code can convert Beta Code literals at compile time.
+*/
+#ifndef UB_TABLE
+#ifdef __cplusplus
+#define UB_TABLE  constexpr
+#define UB_STRING const char *
+#else
+#define UB_TABLE
+#define UB_STRING char *
+#endif
+#endif
+
+
 /*
    The combining marks in polytonic Greek, with classical names.
    These are ORed together to form the row indices in the array
@@ -50,12 +66,20 @@
 #define UB_HEBREW_CLOSE_DOUBLE_QUOTE	0X201D
 
 
+/*
+   Choice of pre-formed accented letters, passed as "accents"
+   to the converters.  See beta2combining and beta2combining_alt.
+*/
+#define UB_GREEK_ACCENTS_OXIA   0  /* all from U+1F00..U+1FFF  */
+#define UB_GREEK_ACCENTS_TONOS  1  /* tonos from U+0370..U+03FF */
+
+
 /*
    Table to convert an ASCII letter into a Unicode Greek letter.
 
    Middle Sigma, Final Sigma, and Lunate Sigma are handled specially elsewhere.
 */
-unsigned ascii2greek[128] = {
+UB_TABLE unsigned ascii2greek[128] = {
 /*   0/8    1/9    2/A    3/B    4/C    5/D    6/E    7/F   */
        0,     0,     0,     0,     0,     0,     0,     0,  /* 0x00..0x07 */
        0,  '\t',  '\n',     0,     0,     0,  '\r',     0,  /* 0x08..0x0F */
@@ -83,7 +107,7 @@ unsigned ascii2greek[128] = {
                0 --> not a combining mark
         non-zero --> Unicode code point of Beta Code combining mark
 */
-unsigned greek_comb2uni[128] = {
+UB_TABLE unsigned greek_comb2uni[128] = {
 /*   0/8    1/9    2/A    3/B    4/C    5/D    6/E    7/F   */
        0,     0,     0,     0,     0,     0,     0,     0,   /* 0x00..0x07 */
        0,     0,     0,     0,     0,     0,     0,     0,   /* 0x08..0x0F */
@@ -159,7 +183,7 @@ unsigned greek_comb2uni[128] = {
     case, software must construct an output string of the
     letter followed by one or more combining characters.
 */
-unsigned beta2combining [128][16] = {
+UB_TABLE unsigned beta2combining [128][16] = {
 /*
                          P
                         Yr
@@ -344,7 +368,7 @@ unsigned beta2combining [128][16] = {
    draw letter glyphs significantly differently between the two
    blocks.
 */
-unsigned beta2combining_alt [128][16] = {
+UB_TABLE unsigned beta2combining_alt [128][16] = {
 /*
                          P
                         Yr
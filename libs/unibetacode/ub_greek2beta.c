@@ -73,7 +73,6 @@ ub_greek2beta (char *utf8_string, int max_utf8_string,
                outposition--;  /* replace "s2" with "s" before another Greek letter */
             }
          }
-         beta_length = strlen (uni03xx_greek_betacode [codept - 0x300]);
          beta_string [outposition++] = codept;
       }
       else if (codept >= 0x300 && codept <= 0x3FF) {  /* Modern Greek */
@@ -85,7 +84,7 @@ ub_greek2beta (char *utf8_string, int max_utf8_string,
                }
             }
             else {  /* next code point isn't a letter, so final small sigma is the default */
-               if (beta_string [outposition - 1] == 2) {
+               if (beta_string [outposition - 1] == '2') {
                   outposition--;  /* replace "s2" with "s" if no Greek letter next */
                }
             }
@@ -106,12 +105,11 @@ ub_greek2beta (char *utf8_string, int max_utf8_string,
                }
             }
             else {  /* next code point isn't a letter, so final small sigma is the default */
-               if (beta_string [outposition - 1] == 2) {
+               if (beta_string [outposition - 1] == '2') {
                   outposition--;  /* replace "s2" with "s" if no Greek letter next */
                }
             }
          }
-         beta_length = strlen (uni03xx_greek_betacode [codept - 0x300]);
          beta_length = strlen (uni1Fxx_greek_betacode [codept - 0x1F00]);
          if (beta_length < (max_beta_string - outposition)) {
             strncpy (&beta_string [outposition],
@@ -160,7 +158,7 @@ ub_greek2beta (char *utf8_string, int max_utf8_string,
    */
    if (outposition >= 2 &&
        beta_string [outposition - 2] == 's' &&
-       beta_string [outposition - 2] == '2') {
+       beta_string [outposition - 1] == '2') {
       outposition--;
    }
 
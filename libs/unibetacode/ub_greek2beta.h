@@ -21,11 +21,27 @@
 */
 
 
+/*
+   Compiled as C++, the tables below are constexpr (and therefore
+   local to each translation unit that includes this file), so C++
+   code can derive packed lookup tables from them at compile time.
+*/
+#ifndef UB_TABLE
+#ifdef __cplusplus
+#define UB_TABLE  constexpr
+#define UB_STRING const char *
+#else
+#define UB_TABLE
+#define UB_STRING char *
+#endif
+#endif
+
+
 /*
    uni03xx_greek_betacode holds Unicode to Greek Beta Code mappings
    for the Unicode range U+0300..U+03FF.
 */
-char *uni03xx_greek_betacode [256] = {
+UB_TABLE UB_STRING uni03xx_greek_betacode [256] = {
    /* U+0300 */  "\\",
    /* U+0301 */  "/",
    /* U+0302 */  "{\\u0302}",
@@ -34,7 +50,7 @@ char *uni03xx_greek_betacode [256] = {
    /* U+0305 */  "{\\u0305}",
    /* U+0306 */  "{\\u0306}",
    /* U+0307 */  "{\\u0307}",
-   /* U+0308 */  "{\\u0308}",
+   /* U+0308 */  "+",
    /* U+0309 */  "{\\u0309}",
    /* U+030A */  "{\\u030A}",
    /* U+030B */  "{\\u030B}",
@@ -95,7 +111,7 @@ char *uni03xx_greek_betacode [256] = {
    /* U+0342 */  "=",
    /* U+0343 */  "{\\u0343}",
    /* U+0344 */  "{\\u0344}",
-   /* U+0345 */  "{\\u0345}",
+   /* U+0345 */  "|",
    /* U+0346 */  "{\\u0346}",
    /* U+0347 */  "{\\u0347}",
    /* U+0348 */  "{\\u0348}",
@@ -289,7 +305,7 @@ char *uni03xx_greek_betacode [256] = {
    uni1Fxx_greek_betacode holds Unicode to Greek Beta Code mappings
    for the Unicode range U+1F00..U+1FFF.
 */
-char *uni1Fxx_greek_betacode [256] = {
+UB_TABLE UB_STRING uni1Fxx_greek_betacode [256] = {
    /* U+1F00 */  "a)",
    /* U+1F01 */  "a(",
    /* U+1F02 */  "a)\\",
@@ -553,7 +569,7 @@ char *uni1Fxx_greek_betacode [256] = {
    ub_isgreek_alpha_03xx - 1 if Unicode code point is a Greek letter
                            in U+0300..U+03FF, 0 otherwise.
 */
-int ub_isgreek_alpha_03xx [256] = {
+UB_TABLE int ub_isgreek_alpha_03xx [256] = {
              /*  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F */
    /* U+0300 */  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
    /* U+0310 */  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -579,7 +595,7 @@ int ub_isgreek_alpha_03xx [256] = {
    ub_isgreek_alpha_1Fxx - 1 if Unicode code point is a Greek letter
                            in U+1F00..U+1FFF, 0 otherwise.
 */
-int ub_isgreek_alpha_1Fxx [256] = {
+UB_TABLE int ub_isgreek_alpha_1Fxx [256] = {
              /*  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F */
    /* U+1F00 */  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
    /* U+1F10 */  1, 1, 1, 1, 1, 1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0,
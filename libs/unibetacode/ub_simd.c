@@ -0,0 +1,222 @@
+/*
+   ub_simd.c - vectorized run scanning for the Beta Code and UTF-8
+               converters.  The converters hand a run found here to a
+               bulk copy loop and fall back to their per-character
+               state machines only where the run stops.
+
+   Uses SSE2 (x86-64), NEON (AArch64) or WebAssembly SIMD128 when the
+   compiler targets them, and a table-driven scalar loop otherwise.
+   Defining UB_SCALAR_ONLY drops the vector code here and the bulk
+   path in ub_beta2greek.c, leaving the original per-character
+   converter; output is byte-identical either way.
+
+   LICENSE:
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 2 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if !defined(UB_SCALAR_ONLY)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define UB_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define UB_SIMD_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define UB_SIMD_WASM
+#endif
+#endif
+
+
+/*
+   ub_beta_plain - classification of Beta Code bytes for the bulk path.
+
+        0 --> needs the full scanner (capitals, sigma, combining
+              marks, quotes, punctuation with a Greek mapping, and
+              anything outside 7-bit ASCII)
+        1 --> passes through to UTF-8 unchanged
+        2 --> Latin letter other than s/S, a plain Greek letter
+              unless a combining mark follows it
+*/
+static const unsigned char ub_beta_plain[128] = {
+/*   0/8 1/9 2/A 3/B 4/C 5/D 6/E 7/F */
+       0,  0,  0,  0,  0,  0,  0,  0,  /* 0x00..0x07 */
+       0,  1,  1,  0,  0,  0,  0,  0,  /* 0x08..0x0F */
+       0,  0,  0,  0,  0,  0,  0,  0,  /* 0x10..0x17 */
+       0,  0,  0,  0,  0,  0,  0,  0,  /* 0x18..0x1F */
+       1,  1,  0,  0,  1,  1,  1,  0,  /* 0x20..0x27  !"#$%&' */
+       0,  0,  0,  0,  1,  0,  1,  0,  /* 0x28..0x2F ()*+,-./ */
+       1,  1,  1,  1,  1,  1,  1,  1,  /* 0x30..0x37 01234567 */
+       1,  1,  0,  1,  0,  0,  0,  0,  /* 0x38..0x3F 89:;<=>? */
+       1,  2,  2,  2,  2,  2,  2,  2,  /* 0x40..0x47 @ABCDEFG */
+       2,  2,  2,  2,  2,  2,  2,  2,  /* 0x48..0x4F HIJKLMNO */
+       2,  2,  2,  0,  2,  2,  2,  2,  /* 0x50..0x57 PQRSTUVW */
+       2,  2,  2,  1,  0,  1,  1,  0,  /* 0x58..0x5F XYZ[\]^_ */
+       1,  2,  2,  2,  2,  2,  2,  2,  /* 0x60..0x67 `abcdefg */
+       2,  2,  2,  2,  2,  2,  2,  2,  /* 0x68..0x6F hijklmno */
+       2,  2,  2,  0,  2,  2,  2,  2,  /* 0x70..0x77 pqrstuvw */
+       2,  2,  2,  1,  0,  1,  1,  0   /* 0x78..0x7F xyz{|}~<DEL> */
+/*   0/8 1/9 2/A 3/B 4/C 5/D 6/E 7/F */
+};
+
+
+/*
+   ub_beta_plain_block - 1 if all 16 bytes at s are letters other
+                         than s/S, digits, spaces, commas or periods,
+                         the common subset of ub_beta_plain that the
+                         vector units can test in a few compares.
+*/
+#if defined(UB_SIMD_SSE2)
+static int
+ub_beta_plain_block (const char *s) {
+   __m128i v      = _mm_loadu_si128 ((const __m128i *) s);
+   __m128i lower  = _mm_or_si128 (v, _mm_set1_epi8 (0x20));
+   __m128i letter = _mm_and_si128 (_mm_cmpgt_epi8 (lower, _mm_set1_epi8 ('a' - 1)),
+                                   _mm_cmplt_epi8 (lower, _mm_set1_epi8 ('z' + 1)));
+   __m128i digit  = _mm_and_si128 (_mm_cmpgt_epi8 (v, _mm_set1_epi8 ('0' - 1)),
+                                   _mm_cmplt_epi8 (v, _mm_set1_epi8 ('9' + 1)));
+   __m128i punct  = _mm_or_si128 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (' ')),
+                    _mm_or_si128 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (',')),
+                                  _mm_cmpeq_epi8 (v, _mm_set1_epi8 ('.'))));
+   letter = _mm_andnot_si128 (_mm_cmpeq_epi8 (lower, _mm_set1_epi8 ('s')), letter);
+   return _mm_movemask_epi8 (_mm_or_si128 (letter, _mm_or_si128 (digit, punct))) == 0xFFFF;
+}
+#elif defined(UB_SIMD_NEON)
+static int
+ub_beta_plain_block (const char *s) {
+   uint8x16_t v      = vld1q_u8 ((const uint8_t *) s);
+   uint8x16_t lower  = vorrq_u8 (v, vdupq_n_u8 (0x20));
+   uint8x16_t letter = vandq_u8 (vcgeq_u8 (lower, vdupq_n_u8 ('a')),
+                                 vcleq_u8 (lower, vdupq_n_u8 ('z')));
+   uint8x16_t digit  = vandq_u8 (vcgeq_u8 (v, vdupq_n_u8 ('0')),
+                                 vcleq_u8 (v, vdupq_n_u8 ('9')));
+   uint8x16_t punct  = vorrq_u8 (vceqq_u8 (v, vdupq_n_u8 (' ')),
+                       vorrq_u8 (vceqq_u8 (v, vdupq_n_u8 (',')),
+                                 vceqq_u8 (v, vdupq_n_u8 ('.'))));
+   letter = vbicq_u8 (letter, vceqq_u8 (lower, vdupq_n_u8 ('s')));
+   return vminvq_u8 (vorrq_u8 (letter, vorrq_u8 (digit, punct))) == 0xFF;
+}
+#elif defined(UB_SIMD_WASM)
+static int
+ub_beta_plain_block (const char *s) {
+   v128_t v      = wasm_v128_load (s);
+   v128_t lower  = wasm_v128_or (v, wasm_u8x16_splat (0x20));
+   v128_t letter = wasm_v128_and (wasm_u8x16_ge (lower, wasm_u8x16_splat ('a')),
+                                  wasm_u8x16_le (lower, wasm_u8x16_splat ('z')));
+   v128_t digit  = wasm_v128_and (wasm_u8x16_ge (v, wasm_u8x16_splat ('0')),
+                                  wasm_u8x16_le (v, wasm_u8x16_splat ('9')));
+   v128_t punct  = wasm_v128_or (wasm_i8x16_eq (v, wasm_u8x16_splat (' ')),
+                   wasm_v128_or (wasm_i8x16_eq (v, wasm_u8x16_splat (',')),
+                                 wasm_i8x16_eq (v, wasm_u8x16_splat ('.'))));
+   letter = wasm_v128_andnot (letter, wasm_i8x16_eq (lower, wasm_u8x16_splat ('s')));
+   return wasm_i8x16_all_true (wasm_v128_or (letter, wasm_v128_or (digit, punct)));
+}
+#endif
+
+
+/*
+   ub_beta_plain_span - length of the prefix of a Beta Code string
+                        that converts byte by byte, with no capitals,
+                        sigma, quotes or combining marks.  A letter
+                        directly followed by a combining mark is left
+                        out of the run so the scanner sees both.
+
+   Inputs:
+
+        beta_string        Beta Code bytes, not necessarily null-terminated.
+
+        max_beta_string    number of bytes available.
+
+   Return value: length of the run, 0 if the first byte needs the scanner.
+*/
+int
+ub_beta_plain_span (const char *beta_string, int max_beta_string) {
+
+   int  span;         /* bytes accepted so far    */
+   int  thischar;     /* current byte, as 0..255  */
+
+   span = 0;
+
+#if defined(UB_SIMD_SSE2) || defined(UB_SIMD_NEON) || defined(UB_SIMD_WASM)
+   while (span + 16 <= max_beta_string && ub_beta_plain_block (&beta_string [span])) {
+      span += 16;
+   }
+#endif
+
+   while (span < max_beta_string) {
+      thischar = beta_string [span] & 0xFF;
+      if (thischar >= 0x80 || ub_beta_plain [thischar] == 0)
+         break;
+      span++;
+   }
+
+   /* A trailing letter owns any combining marks that follow it. */
+   if (span > 0 && span < max_beta_string &&
+       ub_beta_plain [beta_string [span - 1] & 0x7F] == 2) {
+      switch (beta_string [span] & 0x7F) {  /* the scanner masks to 7 bits too */
+         case '(': case ')': case '+': case '/':
+         case '=': case '\\': case '|':
+            span--;
+            break;
+         default:
+            break;
+      }
+   }
+
+   return span;
+}
+
+
+/*
+   ub_ascii_span - length of the 7-bit ASCII prefix of a UTF-8 string.
+
+   Inputs:
+
+        utf8_string        UTF-8 bytes, not necessarily null-terminated.
+
+        max_utf8_string    number of bytes available.
+
+   Return value: number of leading bytes below 0x80.
+*/
+int
+ub_ascii_span (const unsigned char *utf8_string, int max_utf8_string) {
+
+   int span;  /* bytes accepted so far */
+
+   span = 0;
+
+#if defined(UB_SIMD_SSE2)
+   while (span + 16 <= max_utf8_string &&
+          _mm_movemask_epi8 (_mm_loadu_si128 ((const __m128i *) &utf8_string [span])) == 0) {
+      span += 16;
+   }
+#elif defined(UB_SIMD_NEON)
+   while (span + 16 <= max_utf8_string &&
+          vmaxvq_u8 (vld1q_u8 (&utf8_string [span])) < 0x80) {
+      span += 16;
+   }
+#elif defined(UB_SIMD_WASM)
+   while (span + 16 <= max_utf8_string &&
+          wasm_i8x16_bitmask (wasm_v128_load (&utf8_string [span])) == 0) {
+      span += 16;
+   }
+#endif
+
+   while (span < max_utf8_string && utf8_string [span] < 0x80) {
+      span++;
+   }
+
+   return span;
+}
@@ -43,49 +43,37 @@
 int
 ub_codept2utf8 (unsigned codept, char *utf8_bytes)
 {
-   int i;              /* loop variable                              */
-   int bin_length;     /* number of binary digits, for forming UTF-8 */
    int utf8_length;    /* numberof bytes of UTF-8                    */
 
-   int ub_bin_digits (unsigned);
-
-   utf8_length = 0;  /* no UTF-8 string written yet */
-
-
    /*
-      If within valid 0x2039Unicode range of U+0000..U+10FFFF, proceed
+      Compare against the range limits directly rather than counting
+      binary digits; this runs once per output character.
    */
-   if (codept <= 0x10FFFF) {
-      bin_length = ub_bin_digits (codept);
-      if (bin_length < 8) {        /* U+0000..U+007F */
-         utf8_bytes [0] = codept;
-         utf8_bytes [1] = '\0';
-         utf8_length = 1;
-      }
-      else if (bin_length < 12) {  /* U+0080..U+07FF */
-         utf8_bytes [0] = 0xC0 | ((codept >>  6) & 0x1F);
-         utf8_bytes [1] = 0x80 | ( codept        & 0x3F);
-         utf8_bytes [2] = '\0';
-         utf8_length = 2;
-      }
-      else if (bin_length < 17) {  /* U+0800..U+FFFF */
-         utf8_bytes [0] = 0xE0 | ((codept >> 12) & 0x0F);
-         utf8_bytes [1] = 0x80 | ((codept >>  6) & 0x3F);
-         utf8_bytes [2] = 0x80 | ( codept        & 0x3F);
-         utf8_bytes [3] = '\0';
-         utf8_length = 3;
-      }
-      else if (bin_length < 22) {  /* U+010000..U+10FFFF */
-         utf8_bytes [0] = 0xF0 | ((codept >> 18) & 0x07);
-         utf8_bytes [1] = 0x80 | ((codept >> 12) & 0x3F);
-         utf8_bytes [2] = 0x80 | ((codept >>  6) & 0x3F);
-         utf8_bytes [3] = 0x80 | ( codept        & 0x3F);
-         utf8_bytes [4] = '\0';
-         utf8_length = 4;
-      }
-      else {
-         utf8_length = 0;
-      }
+   if (codept < 0x80) {              /* U+0000..U+007F */
+      utf8_bytes [0] = codept;
+      utf8_bytes [1] = '\0';
+      utf8_length = 1;
+   }
+   else if (codept < 0x800) {        /* U+0080..U+07FF */
+      utf8_bytes [0] = 0xC0 | ((codept >>  6) & 0x1F);
+      utf8_bytes [1] = 0x80 | ( codept        & 0x3F);
+      utf8_bytes [2] = '\0';
+      utf8_length = 2;
+   }
+   else if (codept < 0x10000) {      /* U+0800..U+FFFF */
+      utf8_bytes [0] = 0xE0 | ((codept >> 12) & 0x0F);
+      utf8_bytes [1] = 0x80 | ((codept >>  6) & 0x3F);
+      utf8_bytes [2] = 0x80 | ( codept        & 0x3F);
+      utf8_bytes [3] = '\0';
+      utf8_length = 3;
+   }
+   else if (codept <= 0x10FFFF) {    /* U+010000..U+10FFFF */
+      utf8_bytes [0] = 0xF0 | ((codept >> 18) & 0x07);
+      utf8_bytes [1] = 0x80 | ((codept >> 12) & 0x3F);
+      utf8_bytes [2] = 0x80 | ((codept >>  6) & 0x3F);
+      utf8_bytes [3] = 0x80 | ( codept        & 0x3F);
+      utf8_bytes [4] = '\0';
+      utf8_length = 4;
    }
    else {
       utf8_length = 0;
@@ -114,16 +102,21 @@ ub_codept2utf8 (unsigned codept, char *utf8_bytes)
 int
 ub_bin_digits (unsigned itest)
 {
-   unsigned i;
    int result;
 
    itest &= 0xFFFFFFFF;  /* in case "unsigned" is ever > 32 bits  */
+#if defined(__GNUC__) || defined(__clang__)
+   result = itest == 0 ? 0 : 32 - __builtin_clz (itest);
+#else
+   unsigned i;
+
    i      = 0x80000000;  /* mask highest 32-bit unsigned bit      */
    result = 32;
    while (  (i != 0) && ((itest & i) == 0) ) {
        i >>= 1;
        result--;
    }
+#endif
 
    return result;
 }
@@ -158,19 +151,21 @@ ub_utf82codept (unsigned char *utf8_seq, unsigned *codept) {
    unsigned this_byte;  /* current byte being processed             */
    int nbytes;          /* return value: length of UTF-8 code point */
 
-   mask      = 0x80;  /* start with masking off high bit in first byte */
-   nbytes    =    0;  /* no byte count for UTF-8 sequence yet          */
-   *codept   =    0;  /* reset Unicode code point value to 0           */
-
    this_byte = utf8_seq [0] & 0xFF;
 
-   while ((this_byte & mask) != 0) {
-      nbytes++;           /* sequence is one more byte long */
-      this_byte ^= mask;  /* turn off current mask bit      */
-      mask >>= 1;         /* prepare to examine next bit    */
-   }
-
-   *codept = this_byte;  /* high-order bits were already set to 0 */
+   /* The count of leading 1 bits in the first byte gives the length. */
+   if      (this_byte < 0x80) nbytes = 0;
+   else if (this_byte < 0xC0) nbytes = 1;
+   else if (this_byte < 0xE0) nbytes = 2;
+   else if (this_byte < 0xF0) nbytes = 3;
+   else if (this_byte < 0xF8) nbytes = 4;
+   else if (this_byte < 0xFC) nbytes = 5;  /* invalid from here on */
+   else if (this_byte < 0xFE) nbytes = 6;
+   else if (this_byte < 0xFF) nbytes = 7;
+   else                       nbytes = 8;
+
+   mask    = 0xFF >> (nbytes + 1);  /* payload bits of the first byte */
+   *codept = this_byte & mask;
 
    if (nbytes == 0) {  /* ASCII -- just return it */
       nbytes  = 1;
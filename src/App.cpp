@@ -35,7 +35,7 @@ App::~App()
     }
 }
 
-App::App() : dbm(":memory:")
+App::App()
 {
     setFlexLayout(true);
     layout().setFlexRows(true);
@@ -56,6 +56,7 @@ App::App() : dbm(":memory:")
     header.addChild(markBtn);
     header.addChild(helpBtn);
     header.addChild(reverseBtn);
+    header.addChild(matchBtn);
 
     lessonLabel.layout().setDimensions(8_vw, 100_vh);
     lesson.layout().setDimensions(5_vw, 100_vh);
@@ -63,6 +64,7 @@ App::App() : dbm(":memory:")
     markBtn.layout().setDimensions(11_vw, 100_vh);
     helpBtn.layout().setDimensions(5_vw, 100_vh);
     reverseBtn.layout().setDimensions(9_vw, 100_vh);
+    matchBtn.layout().setDimensions(9_vw, 100_vh);
 
     lessonLabel.setText("Lesson #");
     lessonLabel.setFont(font.withSize(20.f));
@@ -98,6 +100,9 @@ App::App() : dbm(":memory:")
     reverseBtn.setFont(font.withSize(25.f));
     reverseBtn.onMouseDown() = [&](const visage::MouseEvent &e) { switchQs(); };
 
+    matchBtn.setFont(font.withSize(25.f));
+    matchBtn.onMouseDown() = [&](const visage::MouseEvent &e) { switchHeadMatch(); };
+
     // ============================
 
     body.setFlexLayout(true);
@@ -108,7 +113,7 @@ App::App() : dbm(":memory:")
 
     for (int i = 0; i < MAX_ROWS; ++i)
     {
-        auto qi = new QuizItem();
+        auto qi = new QuizItem(grader);
         auto qr = new gwr::gkrv::QuizRevItem();
         qi->layout().setDimensions(99_vw, 11_vh);
         qr->layout().setDimensions(99_vw, 11_vh);
@@ -134,7 +139,7 @@ void App::newQuiz(int lessonNum)
     {
         if (!isReverse)
         {
-            qis[j]->dbForms.clear();
+            qis[j]->dbForm.clear();
             qis[j]->clearAll();
         }
         else
@@ -144,84 +149,32 @@ void App::newQuiz(int lessonNum)
         }
     }
 
-    // getQuery
-    auto st = dbm.getStmt(
-        "select id, inflected, head, parse, lesson from newmorphs where lesson <= ? order "
-        "by random() limit ?");
-    st.bind(1, lessonNum);
-    st.bind(2, MAX_ROWS);
-
-    // loadResults
-    if (!isReverse)
+    // rows are picked and looked up in memory
+    size_t i{0};
+    for (int id : sampler.sample(lessonNum, MAX_ROWS))
     {
-        size_t i{0};
-        while (st.executeStep())
+        uint32_t row = morphs.findId(id);
+        if (row == MorphStore::kNone)
+            continue;
+        dbEntry d = morphs.entry(row);
+        if (!isReverse)
         {
-            dbEntry d;
-            d.id = st.getColumn("id").getInt();
-            d.head = st.getColumn("head").getString();
-            d.inflected = st.getColumn("inflected").getString();
-            d.parse = st.getColumn("parse").getString();
-            d.lesson = st.getColumn("lesson").getInt();
-            qis[i]->dbForms.push_back(d);
-            qis[i]->promptDb.setText(bc::beta2greek(d.inflected));
-            ++i;
+            qis[i]->dbForm = d;
+            qis[i]->promptDb.setText(std::string{d.inflectedGk.view()});
         }
-        getAlts();
-    }
-    else
-    {
-        size_t i{0};
-        while (st.executeStep())
+        else
         {
-            dbEntry d;
-            d.id = st.getColumn("id").getInt();
-            d.head = st.getColumn("head").getString();
-            d.inflected = st.getColumn("inflected").getString();
-            d.parse = st.getColumn("parse").getString();
-            d.lesson = st.getColumn("lesson").getInt();
             qrs[i]->dbForm = d;
-            qrs[i]->headwordDb.setText(bc::beta2greek(d.head));
-            qrs[i]->parseDb.setText(d.parse);
-            ++i;
+            qrs[i]->headwordDb.setText(std::string{d.headGk.view()});
+            qrs[i]->parseDb.setText(std::string{d.parse.view()});
         }
+        ++i;
     }
-
     userInputIsShown = true;
     quizIsMarked = false;
     redraw();
 }
 
-void App::getAlts()
-{
-    for (size_t i = 0; i < MAX_ROWS; ++i)
-    {
-        std::vector<dbEntry> alts;
-        dbEntry root;
-        root.id = qis[i]->dbForms[0].id;
-        root.head = qis[i]->dbForms[0].head;
-        root.inflected = qis[i]->dbForms[0].inflected;
-        root.parse = qis[i]->dbForms[0].parse;
-        auto st = dbm.getStmt("select * from newmorphs where inflected = ? and parse != ?");
-        st.bind(1, root.inflected);
-        st.bind(2, root.parse);
-        while (st.executeStep())
-        {
-            dbEntry d;
-            d.id = st.getColumn("id").getInt();
-            d.head = st.getColumn("head").getString();
-            d.inflected = st.getColumn("inflected").getString();
-            d.parse = st.getColumn("parse").getString();
-            d.lesson = st.getColumn("lesson").getInt();
-            alts.push_back(d);
-        }
-        for (auto &alt : alts)
-        {
-            qis[i]->dbForms.push_back(alt);
-        }
-    }
-}
-
 void App::markQuiz()
 {
     if (!userInputIsShown)
@@ -283,4 +236,17 @@ void App::switchQs()
     redraw();
 }
 
+void App::switchHeadMatch()
+{
+    // the button names how headwords are marked now
+    bool letters = headMatch == HeadMatch::Accents;
+    headMatch = letters ? HeadMatch::Letters : HeadMatch::Accents;
+    matchBtn.setText(letters ? "Letters" : "Accents");
+    for (auto qi : qis)
+        qi->headMatch = headMatch;
+    if (quizIsMarked && !isReverse)
+        markQuiz();
+    redraw();
+}
+
 } // namespace gwr::gkqz
\ No newline at end of file
@@ -22,11 +22,14 @@
 #include <visage_file_embed/embedded_file.h>
 #include "embedded/example_fonts.h"
 #include "embedded/fonts.h"
+#include "embedded/mydbs.h"
 #include <visage_widgets/button.h>
 #include <visage_widgets/text_editor.h>
 #include <visage_utils/dimension.h>
 #include <emscripten.h>
-#include "DbManager.h"
+#include "Grader.h"
+#include "MorphStore.h"
+#include "QuizSampler.h"
 #include "Label.h"
 #include "QuizItem.h"
 #include "QuizRevItem.h"
@@ -44,14 +47,19 @@ class App : public visage::ApplicationWindow
     void draw(visage::Canvas &canvas) override;
     void newQuiz();
     void newQuiz(int lesson);
-    void getAlts();
     void markQuiz();
     void clearColors();
     void switchQs();
+    void switchHeadMatch();
     bool userInputIsShown{true}, quizIsMarked{false}, isReverse{false};
-    DbManager dbm;
+    HeadMatch headMatch{HeadMatch::Accents}; // Letters marks headwords without their accents
+    MorphStore morphs{
+        MorphImage{resources::dbs::gkqz_img.data, (size_t)resources::dbs::gkqz_img.size}};
+    QuizSampler sampler{morphs}; // after morphs, which these read from
+    Grader grader{morphs};
     visage::Font font{50, visage::fonts::Lato_Regular_ttf};
-    visage::UiButton newBtn{"New"}, markBtn{"Mark"}, helpBtn{"?"}, reverseBtn{"Reverse"};
+    visage::UiButton newBtn{"New"}, markBtn{"Mark"}, helpBtn{"?"}, reverseBtn{"Reverse"},
+        matchBtn{"Accents"};
     Label lessonLabel, header, body;
     visage::TextEditor lesson;
     std::array<QuizItem *, MAX_ROWS> qis;
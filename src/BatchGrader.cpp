@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "BatchGrader.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace gwr::gkqz
+{
+
+namespace
+{
+
+constexpr uint32_t kChunk{64}; // submissions a worker takes from its own range at a time
+
+} // namespace
+
+// A worker's remaining submissions [begin, end), packed into one word so the owner
+// can take from the front while thieves take from the back, each with one CAS.
+struct alignas(64) BatchGrader::Range
+{
+    std::atomic<uint64_t> bounds{0};
+
+    static uint64_t pack(uint32_t begin, uint32_t end) { return (uint64_t)begin << 32 | end; }
+
+    bool takeFront(uint32_t &begin, uint32_t &end)
+    {
+        uint64_t v = bounds.load(std::memory_order_acquire);
+        for (;;)
+        {
+            uint32_t b = (uint32_t)(v >> 32), e = (uint32_t)v;
+            if (b >= e)
+                return false;
+            uint32_t next = std::min(b + kChunk, e);
+            if (bounds.compare_exchange_weak(v, pack(next, e), std::memory_order_acq_rel))
+            {
+                begin = b;
+                end = next;
+                return true;
+            }
+        }
+    }
+
+    // the back half, or all of it if that is only a chunk
+    bool stealBack(uint32_t &begin, uint32_t &end)
+    {
+        uint64_t v = bounds.load(std::memory_order_acquire);
+        for (;;)
+        {
+            uint32_t b = (uint32_t)(v >> 32), e = (uint32_t)v;
+            if (b >= e)
+                return false;
+            uint32_t mid = e - b <= kChunk ? b : b + (e - b) / 2;
+            if (bounds.compare_exchange_weak(v, pack(b, mid), std::memory_order_acq_rel))
+            {
+                begin = mid;
+                end = e;
+                return true;
+            }
+        }
+    }
+};
+
+size_t itemCount(std::span<const Submission> submissions)
+{
+    size_t n{0};
+    for (auto &s : submissions)
+        n += s.items.size();
+    return n;
+}
+
+BatchGrader::BatchGrader(const Grader &grader, unsigned threads, HeadMatch match)
+    : grader_(grader), match_(match),
+      ranges_(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+    for (unsigned t = 1; t < ranges_.size(); ++t)
+        workers_.emplace_back([this, t] { serve(t); });
+}
+
+BatchGrader::~BatchGrader()
+{
+    {
+        std::lock_guard lock{mutex_};
+        stop_ = true;
+    }
+    wake_.notify_all();
+    workers_.clear(); // joins
+}
+
+void BatchGrader::grade(std::span<const Submission> submissions, std::span<ItemResult> results)
+{
+    if (results.size() != itemCount(submissions))
+        throw std::invalid_argument("BatchGrader: results must have one element per item");
+    if (submissions.size() > 0xffffffffu)
+        throw std::invalid_argument("BatchGrader: too many submissions");
+
+    submissions_ = submissions;
+    results_ = results;
+    first_.resize(submissions.size());
+    for (size_t i = 0, at = 0; i < submissions.size(); at += submissions[i++].items.size())
+        first_[i] = at;
+
+    uint32_t n = (uint32_t)submissions.size();
+    unsigned threads = (unsigned)ranges_.size();
+    if (threads == 1 || n <= kChunk)
+    {
+        gradeRange(0, n);
+        return;
+    }
+    for (unsigned t = 0; t < threads; ++t)
+        ranges_[t].bounds = Range::pack((uint32_t)((uint64_t)n * t / threads),
+                                        (uint32_t)((uint64_t)n * (t + 1) / threads));
+    {
+        std::lock_guard lock{mutex_};
+        ++batch_;
+        busy_ = threads - 1;
+    }
+    wake_.notify_all();
+    work(0);
+    std::unique_lock lock{mutex_};
+    done_.wait(lock, [this] { return busy_ == 0; });
+}
+
+void BatchGrader::gradeRange(uint32_t begin, uint32_t end)
+{
+    const MorphStore &morphs = grader_.morphs();
+    for (uint32_t s = begin; s < end; ++s)
+    {
+        ItemResult *out = &results_[first_[s]];
+        for (auto &item : submissions_[s].items)
+        {
+            ItemResult r;
+            uint32_t row = morphs.findId(item.id);
+            if (row != MorphStore::kNone)
+            {
+                auto g = grader_.grade(morphs.forms()[row], item.head, item.parse, match_);
+                r = {true, g.head, g.parse,
+                     g.match == MorphStore::kNone ? 0 : morphs.ids()[g.match], g.headTooLong};
+            }
+            *out++ = r;
+        }
+    }
+}
+
+void BatchGrader::work(unsigned self)
+{
+    unsigned threads = (unsigned)ranges_.size();
+    uint32_t begin, end;
+    for (;;)
+    {
+        while (ranges_[self].takeFront(begin, end))
+            gradeRange(begin, end);
+        // out of work: take half of someone else's and make it our own range
+        bool stole{false};
+        for (unsigned k = 1; k < threads && !stole; ++k)
+            stole = ranges_[(self + k) % threads].stealBack(begin, end);
+        if (!stole)
+            return;
+        ranges_[self].bounds.store(Range::pack(begin, end), std::memory_order_release);
+    }
+}
+
+// a worker thread: one work() per batch until the BatchGrader goes
+void BatchGrader::serve(unsigned self)
+{
+    uint64_t seen{0};
+    for (;;)
+    {
+        {
+            std::unique_lock lock{mutex_};
+            wake_.wait(lock, [&] { return stop_ || batch_ != seen; });
+            if (stop_)
+                return;
+            seen = batch_;
+        }
+        work(self);
+        std::lock_guard lock{mutex_};
+        if (--busy_ == 0)
+            done_.notify_one();
+    }
+}
+
+} // namespace gwr::gkqz
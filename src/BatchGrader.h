@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Grader.h"
+
+namespace gwr::gkqz
+{
+
+// One answer from a class submission, as the student typed it.
+struct SubmissionItem
+{
+    int id{0};         // newmorphs id of the prompt
+    std::string head;  // Beta Code
+    std::string parse; // e.g. "aor ind act 3rd sg"
+};
+
+struct Submission
+{
+    std::string student;
+    std::vector<SubmissionItem> items;
+};
+
+struct ItemResult
+{
+    bool known{false}; // false if id is not a row of the store; then nothing is right
+    bool head{false}, parse{false};
+    int match{0};            // id of the row the answer names, 0 if none
+    bool headTooLong{false}; // the headword was over HeadKey::kMaxHead, so not marked
+};
+
+// Number of items in all of submissions, i.e. the size BatchGrader::grade() wants
+// for results.
+size_t itemCount(std::span<const Submission> submissions);
+
+// Grades class submissions on a set of worker threads that live as long as the
+// BatchGrader, so a long run hands block after block to the same workers. The
+// workers split each batch's submissions between them and steal from each
+// other when they run out; all of them read the one Grader, which is never
+// written. match is how strictly headwords are marked.
+class BatchGrader
+{
+  public:
+    // threads counts the caller, which works on each batch too; 0 for one per core
+    explicit BatchGrader(const Grader &grader, unsigned threads = 0,
+                         HeadMatch match = HeadMatch::Accents);
+    ~BatchGrader(); // stops and joins the workers
+    BatchGrader(const BatchGrader &) = delete;
+    BatchGrader &operator=(const BatchGrader &) = delete;
+
+    // Grades every item of every submission into results, which holds the items'
+    // results in submission order, and returns when all are done. One batch at a
+    // time: call it from one thread only.
+    void grade(std::span<const Submission> submissions, std::span<ItemResult> results);
+
+  private:
+    struct Range;
+
+    void gradeRange(uint32_t begin, uint32_t end);
+    void work(unsigned self); // this worker's share of the current batch
+    void serve(unsigned self);
+
+    const Grader &grader_;
+    HeadMatch match_;
+    std::vector<Range> ranges_; // one per worker, the caller's first
+
+    // the current batch, written by grade() before it wakes the workers
+    std::span<const Submission> submissions_;
+    std::span<ItemResult> results_;
+    std::vector<size_t> first_; // where each submission's results start
+
+    std::mutex mutex_;
+    std::condition_variable wake_, done_;
+    uint64_t batch_{0}; // bumped once per batch the workers join in
+    unsigned busy_{0};  // workers still on the current batch
+    bool stop_{false};
+    std::vector<std::jthread> workers_; // last, so they are joined before the rest goes
+};
+
+} // namespace gwr::gkqz
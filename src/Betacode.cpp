@@ -15,21 +15,277 @@
 ////////////////////////////////////////////////////////////////////////// 
 
 #include "Betacode.h"
+#include "BetacodeLiteral.h"
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include "ub_greek2beta.h" // tables only; ub_greek2beta.c is not built
 
-std::string Betacode::beta2greek(const std::string &beta)
+namespace
 {
-    char cstr[150]{0};
-    strncpy(cstr, beta.c_str(), beta.length());
-    char gkstr[150]{0};
-    ub_beta2greek(cstr, 150, gkstr, 150);
-    return std::string(gkstr);
+
+// U+0300..U+03FF and U+1F00..U+1FFF flattened into one pool, so each code
+// point is a single {offset, length} lookup instead of a strlen per char
+struct BetaSpan
+{
+    uint16_t offset{0};
+    uint8_t length{0};
+    uint8_t isAlpha{0};
+};
+
+constexpr const char *betaEntry(size_t i)
+{
+    return i < 256 ? uni03xx_greek_betacode[i] : uni1Fxx_greek_betacode[i - 256];
+}
+
+constexpr size_t entryLength(const char *s)
+{
+    size_t n{0};
+    while (s[n] != '\0')
+        ++n;
+    return n;
 }
+
+constexpr size_t poolSize()
+{
+    size_t n{0};
+    for (size_t i = 0; i < 512; ++i)
+        n += entryLength(betaEntry(i));
+    return n;
+}
+
+struct BetaTable
+{
+    std::array<char, poolSize()> pool{};
+    std::array<BetaSpan, 512> spans{};
+};
+
+constexpr BetaTable buildBetaTable()
+{
+    BetaTable t;
+    size_t at{0};
+    for (size_t i = 0; i < 512; ++i)
+    {
+        auto s = betaEntry(i);
+        auto n = entryLength(s);
+        t.spans[i].offset = (uint16_t)at;
+        t.spans[i].length = (uint8_t)n;
+        t.spans[i].isAlpha =
+            (uint8_t)(i < 256 ? ub_isgreek_alpha_03xx[i] : ub_isgreek_alpha_1Fxx[i - 256]);
+        for (size_t j = 0; j < n; ++j)
+            t.pool[at++] = s[j];
+    }
+    return t;
+}
+
+constexpr BetaTable betaTable = buildBetaTable();
+static_assert(poolSize() < 0xFFFF, "pool offsets must fit in 16 bits");
+
+// decode one code point; invalid or truncated sequences consume one byte and yield U+FFFD
+inline size_t decodeUtf8(const unsigned char *s, size_t n, char32_t &cp)
+{
+    unsigned char b = s[0];
+    if (b < 0x80)
+    {
+        cp = b;
+        return 1;
+    }
+    size_t len = b >= 0xF0 ? 4 : b >= 0xE0 ? 3 : b >= 0xC0 ? 2 : 0;
+    if (len == 0 || len > n || b >= 0xF8)
+    {
+        cp = 0xFFFD;
+        return 1;
+    }
+    cp = b & (0x7F >> len);
+    for (size_t i = 1; i < len; ++i)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            cp = 0xFFFD;
+            return 1;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    return len;
+}
+
+// "s1"/"s2" only need spelling out when they differ from what plain "s" implies
+inline void relaxSigma(char *beta, size_t &out, bool letterFollows)
+{
+    if (out >= 2 && beta[out - 2] == 's')
+    {
+        if (letterFollows && beta[out - 1] == '1')
+            --out;
+        else if (!letterFollows && beta[out - 1] == '2')
+            --out;
+    }
+}
+
+} // namespace
+
+// "_gk" literals must come out exactly as the runtime transcoder writes them.
+// Accented letters are escaped, since their oxia and tonos forms look alike.
+static_assert("lo/gos"_gk == "λ\u1f79γος");
+static_assert("*)/anqrwpos"_gk == "\u1f0cνθρωπος");
+static_assert("ba/rbaros"_gk == "β\u1f71ρβαρος");
+static_assert("tw=|"_gk == "τ\u1ff7");
+static_assert("pai+/s"_gk == "πα\u1fd3ς");
+static_assert("\"ei)=pen\""_gk == "«ε\u1f36πεν»");
+static_assert(greekString<"lo/gos", Accents::Tonos>.view() == "λ\u03ccγος");
+static_assert(greekString<"*)/anqrwpos", Accents::Tonos>.view() == "\u1f0cνθρωπος");
+
+size_t Betacode::beta2greek(std::string_view beta, char *utf8, size_t maxUtf8, Accents accents)
+{
+    if (maxUtf8 == 0)
+        return 0;
+    utf8[0] = '\0';
+    if (beta.empty())
+        return 0;
+    int quoteState{0};
+    return ub_beta2greek_r(beta.data(), (int)beta.size(), utf8, (int)maxUtf8, &quoteState,
+                           (int)accents);
+}
+
+void Betacode::beta2greek(std::string_view beta, std::string &utf8, Accents accents)
+{
+    utf8.resize(greekCapacity(beta.size()));
+    utf8.resize(beta2greek(beta, utf8.data(), utf8.size(), accents));
+}
+
+std::string Betacode::beta2greek(const std::string &beta, Accents accents)
+{
+    std::string gk;
+    beta2greek(std::string_view{beta}, gk, accents);
+    return gk;
+}
+
+size_t Betacode::greek2beta(std::string_view greek, char *beta, size_t maxBeta)
+{
+    if (maxBeta < betaCapacity(greek.size()))
+    {
+        if (maxBeta > 0)
+            beta[0] = '\0';
+        return 0;
+    }
+    auto in = reinterpret_cast<const unsigned char *>(greek.data());
+    size_t n = greek.size(), i{0}, out{0};
+    while (i < n)
+    {
+        if (in[i] < 0x80)
+        {
+            // copy the whole ASCII run at once
+            size_t run = i + ub_ascii_span(in + i, (int)(n - i));
+            relaxSigma(beta, out, false);
+            std::memcpy(beta + out, in + i, run - i);
+            out += run - i;
+            i = run;
+            continue;
+        }
+
+        char32_t cp;
+        i += decodeUtf8(in + i, n - i, cp);
+        size_t idx = (cp >= 0x300 && cp <= 0x3FF)     ? cp - 0x300
+                     : (cp >= 0x1F00 && cp <= 0x1FFF) ? cp - 0x1F00 + 256
+                                                      : 512;
+        if (idx < 512)
+        {
+            auto &span = betaTable.spans[idx];
+            relaxSigma(beta, out, span.isAlpha != 0);
+            std::memcpy(beta + out, betaTable.pool.data() + span.offset, span.length);
+            out += span.length;
+            continue;
+        }
+
+        relaxSigma(beta, out, false);
+        switch (cp)
+        {
+        case 0xAB: // open quotation
+        case 0xBB: // close quotation
+            beta[out++] = '"';
+            break;
+        case 0xB7: // ano teleia
+            beta[out++] = ':';
+            break;
+        case 0x2BC: // modifier letter apostrophe
+        case 0x2019:
+            beta[out++] = '\'';
+            break;
+        case 0x2010: // hyphen
+            beta[out++] = '-';
+            break;
+        case 0x2014: // em dash
+            beta[out++] = '_';
+            break;
+        case 0x2039:
+            beta[out++] = '<';
+            break;
+        case 0x203A:
+            beta[out++] = '>';
+            break;
+        default: // not Greek; keep it visible as an escape
+        {
+            static constexpr char hex[] = "0123456789ABCDEF";
+            char digits[6];
+            int nd{0};
+            for (char32_t v = cp; v != 0 || nd < 4; v >>= 4)
+                digits[nd++] = hex[v & 0xF];
+            beta[out++] = '{';
+            beta[out++] = '\\';
+            beta[out++] = 'u';
+            while (nd > 0)
+                beta[out++] = digits[--nd];
+            beta[out++] = '}';
+        }
+        }
+    }
+    relaxSigma(beta, out, false);
+    beta[out] = '\0';
+    return out;
+}
+
+void Betacode::greek2beta(std::string_view greek, std::string &beta)
+{
+    beta.resize(betaCapacity(greek.size()));
+    beta.resize(greek2beta(greek, beta.data(), beta.size()));
+}
+
 std::string Betacode::greek2beta(const std::string &greek)
 {
-    char gkstr[150]{0};
-    strncpy(gkstr, greek.c_str(), greek.length());
-    char cstr[150]{0};
-    ub_beta2greek(cstr, 150, gkstr, 150);
-    return std::string(cstr);
+    std::string beta;
+    greek2beta(std::string_view{greek}, beta);
+    return beta;
+}
+
+std::span<const std::string_view> BetacodeArena::beta2greek(std::span<const std::string_view> beta,
+                                                            Accents accents)
+{
+    size_t capacity{0};
+    for (auto &b : beta)
+        capacity += Betacode::greekCapacity(b.size());
+    pool_.resize(capacity);
+    ends_.clear();
+    size_t at{0};
+    for (auto &b : beta)
+    {
+        at += Betacode::beta2greek(b, pool_.data() + at, pool_.size() - at, accents);
+        ends_.push_back((uint32_t)at);
+    }
+    pool_.resize(at);
+
+    // views are only taken once the pool has stopped moving
+    views_.clear();
+    size_t start{0};
+    for (auto end : ends_)
+    {
+        views_.emplace_back(pool_.data() + start, end - start);
+        start = end;
+    }
+    return views_;
+}
+
+void BetacodeArena::clear()
+{
+    pool_.clear();
+    ends_.clear();
+    views_.clear();
 }
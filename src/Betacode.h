@@ -17,18 +17,68 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 extern "C"
 {
     // found in unibetacode lib
-    int ub_beta2greek(char *beta, int max_beta, char *utf8gk, int max_utf8);
-    int ub_greek2beta(char *, int, char *, int);
+    int ub_beta2greek(const char *beta, int max_beta, char *utf8gk, int max_utf8);
+    // same, with the open/closed double quote state carried across calls
+    int ub_beta2greek_r(const char *beta, int max_beta, char *utf8gk, int max_utf8,
+                        int *quote_state, int accents);
+    int ub_ascii_span(const unsigned char *utf8, int max_utf8);
 }
 
+// which pre-formed accented letters Betacode converts to; values match UB_GREEK_ACCENTS_*
+enum class Accents
+{
+    Oxia = 0,  // all from Greek Extended, U+1F00..U+1FFF (what gkqz.db holds)
+    Tonos = 1, // tonos forms from U+0370..U+03FF where Unicode has them
+};
+
 struct Betacode
 {
   public:
-    std::string beta{"lo/gos"};
-    static std::string beta2greek(const std::string &utf8);
+    // worst-case UTF-8 size (incl. terminator) of a Betacode string of betaLength bytes
+    static constexpr size_t greekCapacity(size_t betaLength) { return 3 * betaLength + 1; }
+
+    // transcode into a caller-owned buffer of at least greekCapacity(beta.size()) bytes;
+    // returns the number of bytes written, not counting the terminator
+    static size_t beta2greek(std::string_view beta, char *utf8, size_t maxUtf8,
+                             Accents accents = Accents::Oxia);
+    // transcode into a reusable string; only allocates when utf8 has to grow
+    static void beta2greek(std::string_view beta, std::string &utf8,
+                           Accents accents = Accents::Oxia);
+
+    // worst-case Betacode size (incl. terminator) of a UTF-8 string of utf8Length bytes
+    static constexpr size_t betaCapacity(size_t utf8Length) { return 8 * utf8Length + 1; }
+
+    // Unicode Greek (precomposed or combining) back to Betacode, same conventions as above
+    static size_t greek2beta(std::string_view greek, char *beta, size_t maxBeta);
+    static void greek2beta(std::string_view greek, std::string &beta);
+
+    static std::string beta2greek(const std::string &beta, Accents accents = Accents::Oxia);
     static std::string greek2beta(const std::string &greek);
-};
\ No newline at end of file
+};
+
+// Transcodes a batch of Betacode strings into one contiguous UTF-8 buffer, for
+// bulk exports such as gkqz-dbbuild's Greek columns. The buffers are kept
+// between batches, so once they have grown to fit one, later batches of the
+// same size transcode without allocating.
+class BetacodeArena
+{
+  public:
+    // views into the arena, in input order; valid until the next call or clear()
+    std::span<const std::string_view> beta2greek(std::span<const std::string_view> beta,
+                                                 Accents accents = Accents::Oxia);
+    void clear();
+
+  private:
+    std::string pool_;
+    std::vector<uint32_t> ends_;
+    std::vector<std::string_view> views_;
+};
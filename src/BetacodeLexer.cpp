@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "BetacodeLexer.h"
+
+extern "C"
+{
+    // found in unibetacode lib
+    int ub_greek_scanchar(const char *beta, int max_beta, char *beta_char,
+                          unsigned *combining_marks);
+    int ub_beta_plain_span(const char *beta, int max_beta);
+}
+
+size_t BetacodeLexer::lex(std::string_view beta, BetaToken *tokens)
+{
+    size_t in{0}, out{0};
+    while (in < beta.size() && beta[in] != '\0')
+    {
+        // letters without diacritics and punctuation are one token per byte, as in
+        // the converter's bulk path
+        size_t run = in + ub_beta_plain_span(beta.data() + in, (int)(beta.size() - in));
+        for (; in < run; ++in)
+        {
+            char c = beta[in];
+            tokens[out++] = {(c >= 'A' && c <= 'Z') ? (char)(c | 0x20) : c, 0, 0};
+        }
+        if (in == beta.size() || beta[in] == '\0')
+            break;
+
+        char betaChar[4];
+        unsigned marks{0};
+        in += ub_greek_scanchar(beta.data() + in, (int)(beta.size() - in), betaChar, &marks);
+        char c = betaChar[0];
+        if (c == '\0') // '*' with no letter after it
+            continue;
+        BetaToken &t = tokens[out++];
+        t.marks = (uint8_t)(marks & 0x7F);
+        t.sigma = 0;
+        if (c >= 'A' && c <= 'Z')
+        {
+            t.marks |= BetaToken::kCapital;
+            c = (char)(c | 0x20);
+        }
+        else if (c == 's')
+            t.sigma = betaChar[1];
+        t.base = c;
+    }
+    return out;
+}
+
+std::span<const BetaToken> BetacodeLexer::lex(std::string_view beta)
+{
+    if (tokens_.size() < beta.size())
+        tokens_.resize(beta.size());
+    return {tokens_.data(), lex(beta, tokens_.data())};
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// One polytonic Betacode character, as ub_greek_scanchar splits it: base letter,
+// diacritics and case, with no UTF-8 produced. Comparisons, search keys and the
+// like can work on these instead of re-parsing the Betacode text.
+struct BetaToken
+{
+    // diacritic flags, the same bits as UB_GREEK_* in ub_beta2greek.h
+    static constexpr uint8_t kPsili = 0x40;        // smooth breathing
+    static constexpr uint8_t kDasia = 0x20;        // rough breathing
+    static constexpr uint8_t kVaria = 0x10;        // grave
+    static constexpr uint8_t kOxia = 0x08;         // acute
+    static constexpr uint8_t kPerispomeni = 0x04;  // circumflex
+    static constexpr uint8_t kDialytika = 0x02;    // diaeresis
+    static constexpr uint8_t kYpogegrammeni = 0x01; // iota subscript
+    static constexpr uint8_t kCapital = 0x80;      // case bit, '*' in Betacode
+
+    char base{0};     // lowercase Betacode letter, or the input byte for anything else
+    uint8_t marks{0}; // diacritic flags | kCapital
+    char sigma{0};    // for 's' only: '1' medial, '2' final, '3' lunate
+
+    constexpr bool isLetter() const { return base >= 'a' && base <= 'z'; }
+    constexpr bool isCapital() const { return (marks & kCapital) != 0; }
+    constexpr uint8_t diacritics() const { return marks & 0x7F; }
+    friend constexpr bool operator==(const BetaToken &, const BetaToken &) = default;
+};
+static_assert(sizeof(BetaToken) == 3);
+
+// Splits Betacode into BetaTokens. Like ub_beta2greek, it stops at a NUL byte
+// and reads only the low 7 bits of each byte.
+class BetacodeLexer
+{
+  public:
+    // tokens must have room for beta.size() entries (never more than one per byte);
+    // returns the number written
+    static size_t lex(std::string_view beta, BetaToken *tokens);
+
+    // into the lexer's own buffer, which is reused across calls; the span is valid
+    // until the next call
+    std::span<const BetaToken> lex(std::string_view beta);
+
+  private:
+    std::vector<BetaToken> tokens_;
+};
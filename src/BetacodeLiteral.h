@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "Betacode.h"
+#include "ub_beta2greek.h"
+
+// Compile-time Betacode -> UTF-8, for fixed Greek text in the UI:
+//     constexpr std::string_view word = "lo/gos"_gk; // "λόγος", nothing done at runtime
+//     greekString<"lo/gos", Accents::Tonos>.view()   // the same with tonos
+// The conversion steps through ub_beta2greek's logic one character at a time,
+// using its tables, so a literal is byte-identical to Betacode::beta2greek.
+struct BetacodeLiteral
+{
+    // utf8 needs Betacode::greekCapacity(beta.size()) bytes; returns the number
+    // of bytes written, not counting the terminator
+    template <Accents A = Accents::Oxia>
+    static constexpr size_t beta2greek(std::string_view beta, char *utf8)
+    {
+        size_t in{0}, out{0};
+        bool inQuote{false};
+        while (in < beta.size() && beta[in] != '\0')
+        {
+            char betaChar[4]{};
+            unsigned marks{0};
+            size_t scanned = scanChar(beta.substr(in), betaChar, marks);
+            if (betaChar[0] == '"')
+            {
+                // Greek double quotes alternate open/close within a string
+                out += codept2utf8(inQuote ? 0xBB : 0xAB, utf8 + out);
+                inQuote = !inQuote;
+                scanned = 1;
+            }
+            else
+            {
+                size_t n = char2utf8<A>(betaChar, marks, utf8 + out);
+                if (n != 1 || utf8[out] != '\0') // nothing to print, e.g. a dangling '*'
+                    out += n;
+            }
+            in += scanned;
+        }
+        utf8[out] = '\0';
+        return out;
+    }
+
+  private:
+    static constexpr bool isAlpha(char c) { return (c | 0x20) >= 'a' && (c | 0x20) <= 'z'; }
+    static constexpr bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+
+    static constexpr size_t codept2utf8(unsigned cp, char *out)
+    {
+        if (cp < 0x80)
+        {
+            out[0] = (char)cp;
+            return 1;
+        }
+        if (cp < 0x800)
+        {
+            out[0] = (char)(0xC0 | (cp >> 6));
+            out[1] = (char)(0x80 | (cp & 0x3F));
+            return 2;
+        }
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+
+    // ub_greek_scanchar: the letter (with sigma's form spelled out) and its marks
+    static constexpr size_t scanChar(std::string_view beta, char *betaChar, unsigned &marks)
+    {
+        auto at = [beta](size_t i) -> char { return i < beta.size() ? beta[i] & 0x7F : '\0'; };
+        auto scanMarks = [&](size_t &len) {
+            while (unsigned cp = greek_comb2uni[(int)at(len)])
+            {
+                marks |= markFlag(cp);
+                ++len;
+            }
+        };
+        size_t len{0}, out{0};
+        char c = at(0);
+        marks = 0;
+        if (c == '*')
+        {
+            ++len;
+            scanMarks(len);
+            c = at(len);
+            if (isAlpha(c))
+            {
+                betaChar[out++] = (char)(c & ~0x20);
+                ++len;
+                if (at(len) == '|')
+                {
+                    marks |= UB_GREEK_YPOGEGRAMMENI;
+                    ++len;
+                }
+            }
+        }
+        else if (isAlpha(c))
+        {
+            betaChar[out++] = (char)(c | 0x20);
+            ++len;
+            if ((c | 0x20) == 's')
+            {
+                char next = at(1);
+                if (next == '1' || next == '2' || next == '3')
+                {
+                    betaChar[out++] = next;
+                    ++len;
+                }
+                else
+                    betaChar[out++] = next == '\'' || isAlpha(next) ? '1' : '2';
+            }
+            else
+                scanMarks(len);
+        }
+        else
+        {
+            betaChar[out++] = c;
+            ++len;
+        }
+        betaChar[out] = '\0';
+        return len;
+    }
+
+    static constexpr unsigned markFlag(unsigned cp)
+    {
+        switch (cp)
+        {
+        case 0x313: return UB_GREEK_PSILI;
+        case 0x314: return UB_GREEK_DASIA;
+        case 0x300: return UB_GREEK_VARIA;
+        case 0x301: return UB_GREEK_OXIA;
+        case 0x342: return UB_GREEK_PERISPOMENI;
+        case 0x308: return UB_GREEK_DIALYTIKA;
+        case 0x345: return UB_GREEK_YPOGEGRAMMENI;
+        default: return 0;
+        }
+    }
+
+    // ub_greek_char2utf8, including its fallback for marks on a non-vowel
+    template <Accents A> static constexpr size_t char2utf8(const char *betaChar, unsigned marks, char *out)
+    {
+        marks &= 0x7F;
+        char c = betaChar[0];
+        if (marks == 0)
+        {
+            unsigned cp = ascii2greek[(int)c];
+            if (c == 's')
+                cp = betaChar[1] == '1'   ? 0x3C3
+                     : betaChar[1] == '2' ? 0x3C2
+                     : betaChar[1] == '3' ? 0x3F2
+                                          : 's';
+            else if (c == 'S')
+                cp = betaChar[1] == '3' ? 0x3F9 : 0x3A3;
+            return codept2utf8(cp, out);
+        }
+        size_t n = poly2utf8<A>(betaChar, marks, out);
+        if (n != 0)
+            return n;
+        n = codept2utf8((unsigned)c, out);
+        constexpr std::array<std::pair<unsigned, unsigned>, 6> order{
+            {{UB_GREEK_PSILI, 0x313},
+             {UB_GREEK_DASIA, 0x314},
+             {UB_GREEK_VARIA, 0x300},
+             {UB_GREEK_OXIA, 0x301},
+             {UB_GREEK_PERISPOMENI, 0x342},
+             {UB_GREEK_DIALYTIKA, 0x308}}};
+        for (auto [flag, cp] : order)
+            if (marks & flag)
+                n += codept2utf8(cp, out + n);
+        // the C code tests the diaeresis flag here too, not the iota subscript one
+        if (marks & UB_GREEK_DIALYTIKA)
+            n += codept2utf8(isUpper(c) ? 0x1FBE : 0x345, out + n);
+        return n;
+    }
+
+    // ub_greek_poly2utf8: 0 if betaChar is not a vowel or rho
+    template <Accents A> static constexpr size_t poly2utf8(const char *betaChar, unsigned marks, char *out)
+    {
+        constexpr std::string_view letters{"AEHIORUWaehioruw"};
+        size_t column = letters.find(betaChar[0]);
+        if (column == std::string_view::npos)
+            return 0;
+        constexpr auto &table = A == Accents::Tonos ? beta2combining : beta2combining_alt;
+        if (unsigned cp = table[marks][column])
+            return codept2utf8(cp, out);
+        size_t n{0};
+        for (size_t i = 0; betaChar[i] != '\0'; ++i)
+            n += codept2utf8((unsigned)betaChar[i], out + n);
+        constexpr std::array<std::pair<unsigned, unsigned>, 7> order{
+            {{UB_GREEK_DIALYTIKA, 0x308},
+             {UB_GREEK_PSILI, 0x313},
+             {UB_GREEK_DASIA, 0x314},
+             {UB_GREEK_VARIA, 0x300},
+             {UB_GREEK_OXIA, 0x301},
+             {UB_GREEK_PERISPOMENI, 0x342},
+             {UB_GREEK_YPOGEGRAMMENI, 0x345}}};
+        for (auto [flag, cp] : order)
+            if (marks & flag)
+                n += codept2utf8(cp, out + n);
+        return n;
+    }
+};
+
+// a Betacode string literal as a template argument
+template <size_t N> struct BetacodeString
+{
+    static constexpr size_t size = N - 1;
+    char beta[N]{};
+    consteval BetacodeString(const char (&s)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            beta[i] = s[i];
+    }
+    constexpr std::string_view view() const { return {beta, size}; }
+};
+
+// the converted literal, null-terminated
+template <size_t N> struct GreekString
+{
+    std::array<char, N> utf8{};
+    constexpr std::string_view view() const { return {utf8.data(), N - 1}; }
+};
+
+template <BetacodeString B, Accents A> consteval auto makeGreekString()
+{
+    using Buffer = std::array<char, Betacode::greekCapacity(B.size)>;
+    constexpr size_t n = [] {
+        Buffer buf{};
+        return BetacodeLiteral::beta2greek<A>(B.view(), buf.data());
+    }();
+    Buffer buf{};
+    BetacodeLiteral::beta2greek<A>(B.view(), buf.data());
+    GreekString<n + 1> g;
+    for (size_t i = 0; i < n; ++i)
+        g.utf8[i] = buf[i];
+    return g;
+}
+
+// one object per distinct literal, so the views handed out below never dangle
+template <BetacodeString B, Accents A = Accents::Oxia>
+inline constexpr auto greekString = makeGreekString<B, A>();
+
+template <BetacodeString B> consteval std::string_view operator""_gk()
+{
+    return greekString<B>.view();
+}
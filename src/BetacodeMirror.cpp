@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "BetacodeMirror.h"
+#include <algorithm>
+
+// room for one polytonic character with every combining mark spelled out
+static constexpr size_t kMaxCharUtf8 = 17;
+
+const std::string &BetacodeMirror::update(std::string_view beta)
+{
+    // first byte that differs from what we transcoded last time
+    size_t edit = std::mismatch(beta_.begin(), beta_.end(), beta.begin(), beta.end()).first -
+                  beta_.begin();
+    if (edit == beta_.size() && edit == beta.size())
+        return greek_;
+
+    // resume at the character containing the byte before the edit: its lookahead
+    // reaches the edited byte, so a new accent or following letter can change it
+    auto resume = std::upper_bound(starts_.begin(), starts_.end(), edit,
+                                   [](size_t at, const Boundary &b) { return at <= b.beta; });
+    if (resume != starts_.begin())
+        --resume;
+    Boundary at = resume != starts_.end() ? *resume : Boundary{};
+    starts_.erase(resume, starts_.end());
+
+    beta_.resize(at.beta);
+    beta_.append(beta.substr(at.beta));
+    greek_.resize(at.greek);
+
+    size_t in = at.beta, out = at.greek;
+    int quote = at.quoteState;
+    while (in < beta_.size() && beta_[in] != '\0')
+    {
+        starts_.push_back({(uint32_t)in, (uint32_t)out, quote});
+        greek_.resize(out + kMaxCharUtf8);
+        int len{0};
+        in += ub_beta2greek_step(beta_.data() + in, (int)(beta_.size() - in), greek_.data() + out,
+                                 (int)kMaxCharUtf8, &quote, &len, (int)accents_);
+        out += len;
+    }
+    greek_.resize(out);
+    return greek_;
+}
+
+void BetacodeMirror::clear()
+{
+    beta_.clear();
+    greek_.clear();
+    starts_.clear();
+}
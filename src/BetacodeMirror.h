@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Betacode.h"
+
+extern "C"
+{
+    // found in unibetacode lib
+    int ub_beta2greek_step(const char *beta, int max_beta, char *utf8gk, int max_utf8,
+                           int *quote_state, int *utf8_length, int accents);
+}
+
+// Keeps a Greek transcoding of a Betacode field in sync as it is edited.
+// Each polytonic character's start is remembered in both strings, so an edit
+// only re-transcodes from the character just before it (whose marks or sigma
+// form the edit may change) to the end of the field.
+//
+// Only the transcoding is incremental. visage's onTextChange() doesn't say what
+// changed, so each update() still gets the whole field (QuizItem converts it
+// with toUtf8()) and finds the edit with one byte compare over it, and the
+// caller still replaces the whole Label text. Both are O(field length) per
+// keystroke, which is a few dozen bytes for a headword.
+class BetacodeMirror
+{
+  public:
+    explicit BetacodeMirror(Accents accents = Accents::Oxia) : accents_(accents) {}
+
+    // returns the Greek for beta, re-transcoding only what the edit touched
+    const std::string &update(std::string_view beta);
+    const std::string &greek() const { return greek_; }
+    void clear();
+
+  private:
+    struct Boundary
+    {
+        uint32_t beta{0}, greek{0};
+        int quoteState{0};
+    };
+    Accents accents_;
+    std::string beta_, greek_;
+    std::vector<Boundary> starts_; // one per polytonic character, in order
+};
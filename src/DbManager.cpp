@@ -15,18 +15,54 @@
 ////////////////////////////////////////////////////////////////////////// 
 
 #include "DbManager.h"
+#include <stdexcept>
 
 namespace gwr::gkqz
 {
 
-SQLite::Statement DbManager::getStmt(std::string s) { return SQLite::Statement{db, s}; }
+DbManager::Lease DbManager::getStmt(const std::string &sql)
+{
+    auto &pool = idle_[sql];
+    if (pool.empty())
+    {
+        ++misses_;
+        return Lease{pool, std::make_unique<Cached>(db, sql)};
+    }
+    ++hits_;
+    auto cached = std::move(pool.back());
+    pool.pop_back();
+    return Lease{pool, std::move(cached)};
+}
 
-DbManager::DbManager(std::string dbFilename)
-    : db(dbFilename, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE)
+DbManager::Lease::~Lease()
 {
-    int rv = sqlite3_deserialize(
-        db.getHandle(), "main", (unsigned char *)resources::dbs::gkqz_db.data,
-        resources::dbs::gkqz_db.size, resources::dbs::gkqz_db.size, SQLITE_DESERIALIZE_RESIZEABLE);
+    if (!cached_) // moved from
+        return;
+    cached_->stmt.tryReset();
+    cached_->stmt.clearBindings();
+    pool_->push_back(std::move(cached_));
+}
+
+DbManager::DbManager(const void *image, size_t size, std::string userDbFileName)
+    : db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE)
+{
+    // The image becomes "main" in place: READONLY without RESIZEABLE means sqlite
+    // never writes, grows or frees the buffer, so dropping const is safe.
+    int rv = sqlite3_deserialize(db.getHandle(), "main",
+                                 const_cast<unsigned char *>(
+                                     static_cast<const unsigned char *>(image)),
+                                 (sqlite3_int64)size, (sqlite3_int64)size,
+                                 SQLITE_DESERIALIZE_READONLY);
+    if (rv != SQLITE_OK)
+        throw std::runtime_error("cannot open the gkqz.db image: " +
+                                 std::string{sqlite3_errstr(rv)});
+
+    // Let the pager read pages straight out of the image instead of copying each
+    // one into its cache.
+    db.exec("pragma main.mmap_size = " + std::to_string(size));
+
+    // anything the app writes goes here, never into main
+    db.exec("attach database '" + userDbFileName + "' as user");
 }
 
 } // namespace gwr::gkqz
\ No newline at end of file
@@ -17,20 +17,139 @@
 #pragma once
 
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <array>
 #include <iostream>
-#include <visage_file_embed/embedded_file.h>
-#include "embedded/mydbs.h"
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 #include <sqlite3.h>
+#include "Utils.h"
 
 namespace gwr::gkqz
 {
 
+// How query<T> fills a T from a row: the columns it needs, by name, and a read()
+// that takes their indices in the same order. Specialize for each row type.
+template <typename T> struct RowMap;
+
+template <> struct RowMap<dbEntry>
+{
+    static constexpr std::array<const char *, 7> columns{
+        "id", "inflected", "head", "parse", "lesson", "inflected_gk", "head_gk"};
+
+    static void read(SQLite::Statement &st, const int *col, dbEntry &d)
+    {
+        d.id = st.getColumn(col[0]).getInt();
+        d.inflected = intern(st.getColumn(col[1]));
+        d.head = intern(st.getColumn(col[2]));
+        d.parse = intern(st.getColumn(col[3]));
+        d.parseMask = ParseMask::compile(d.parse.view());
+        d.lesson = st.getColumn(col[4]).getInt();
+        d.inflectedGk = intern(st.getColumn(col[5]));
+        d.headGk = intern(st.getColumn(col[6]));
+    }
+
+    static Interned intern(const SQLite::Column &c)
+    {
+        return StringPool::global().intern({c.getText(), (size_t)c.getBytes()});
+    }
+};
+
 class DbManager
 {
+    struct Cached
+    {
+        Cached(SQLite::Database &db, const std::string &sql) : stmt(db, sql) {}
+        SQLite::Statement stmt;
+        const void *mappedTo{nullptr}; // the RowMap columns were resolved for
+        std::vector<int> columns;
+    };
+    using Pool = std::vector<std::unique_ptr<Cached>>;
+
   public:
+    // A compiled statement checked out of the cache. Only its holder can use it;
+    // when the lease ends it is reset, its bindings cleared, and it goes back.
+    class Lease
+    {
+      public:
+        Lease(Lease &&) = default;
+        Lease &operator=(Lease &&) = delete;
+        ~Lease();
+        SQLite::Statement *operator->() const { return &cached_->stmt; }
+        SQLite::Statement &operator*() const { return cached_->stmt; }
+
+        // indices of RowMap<T>::columns in this statement, looked up on first use only
+        template <typename T> const std::vector<int> &columns()
+        {
+            if (cached_->mappedTo != &RowMap<T>::columns)
+            {
+                cached_->columns.clear();
+                for (auto name : RowMap<T>::columns)
+                    cached_->columns.push_back(cached_->stmt.getColumnIndex(name));
+                cached_->mappedTo = &RowMap<T>::columns;
+            }
+            return cached_->columns;
+        }
+
+      private:
+        friend class DbManager;
+        Lease(Pool &pool, std::unique_ptr<Cached> cached)
+            : pool_(&pool), cached_(std::move(cached))
+        {
+        }
+        Pool *pool_;
+        std::unique_ptr<Cached> cached_;
+    };
+
+    // main is a gkqz.db image, read-only and queried where it lies in memory (the
+    // embedded one in the app, a file's bytes in gkqz-dbcheck); user is a small
+    // writable db for per-student state. image must outlive the DbManager.
     SQLite::Database db;
-    DbManager(std::string dbFileName);
-    SQLite::Statement getStmt(std::string s);
+    DbManager(const void *image, size_t size, std::string userDbFileName);
+    // compiles sql only if no idle statement for it is cached
+    Lease getStmt(const std::string &sql);
+
+    // Runs sql with binds for its ?s and maps each row into rows by column index.
+    // rows is overwritten in place, so its capacity is reused from one call to the
+    // next; returns the number of rows.
+    template <typename T, typename... Binds>
+    size_t query(const std::string &sql, std::vector<T> &rows, const Binds &...binds)
+    {
+        auto st = getStmt(sql);
+        const int *col = st.columns<T>().data();
+        int param{0};
+        (bindValue(*st, param, binds), ...);
+        size_t n{0};
+        while (st->executeStep())
+        {
+            if (n == rows.size())
+                rows.emplace_back();
+            RowMap<T>::read(*st, col, rows[n++]);
+        }
+        rows.resize(n);
+        return n;
+    }
+
+    size_t cacheHits() const { return hits_; }
+    size_t cacheMisses() const { return misses_; } // i.e. statements compiled
+
+  private:
+    // a container binds one ? per element, e.g. for "in (?, ?, ?)"
+    template <typename V> static void bindValue(SQLite::Statement &st, int &param, const V &v)
+    {
+        if constexpr (std::ranges::range<V> && !std::is_convertible_v<V, std::string_view>)
+            for (auto &e : v)
+                st.bind(++param, e);
+        else
+            st.bind(++param, v);
+    }
+
+    std::unordered_map<std::string, Pool> idle_; // by SQL text
+    size_t hits_{0}, misses_{0};
 };
 
 } // namespace gwr::gkqz
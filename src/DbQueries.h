@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <array>
+
+namespace gwr::gkqz
+{
+
+// The statements run against gkqz.db. gkqz-dbbuild plans each one before it
+// writes the db and fails if any reads the table row by row, so a query added
+// here that needs an index it lacks breaks the db build, not the quiz.
+struct DbQueries
+{
+    // every row once, for QuizSampler; walks newmorphs_lesson, whose entries
+    // end in the rowid, so no sort is needed
+    static constexpr const char *kLessonOrder{
+        "select id, lesson from newmorphs order by lesson, id"};
+
+    // one row, and the rows with one inflected form, with every RowMap<dbEntry>
+    // column; the form's rows come out in id order since an index entry ends in
+    // the rowid
+    static constexpr const char *kById{"select id, inflected, head, parse, lesson, inflected_gk, "
+                                       "head_gk from newmorphs where id = ?"};
+    static constexpr const char *kByForm{
+        "select id, inflected, head, parse, lesson, inflected_gk, head_gk from newmorphs "
+        "where inflected = ? order by id"};
+
+    static constexpr std::array<const char *, 3> all{kLessonOrder, kById, kByForm};
+};
+
+} // namespace gwr::gkqz
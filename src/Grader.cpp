@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "Grader.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace gwr::gkqz
+{
+
+Grader::Grader(const MorphStore &morphs) : morphs_(morphs)
+{
+    uint32_t forms{0};
+    for (auto f : morphs.forms())
+        forms = std::max(forms, f.id + 1);
+    start_.reserve(forms + 1);
+    answers_.reserve(morphs.size());
+
+    // a headword's keys, made once however many rows share it
+    StringPool &pool = StringPool::global();
+    std::vector<std::array<Interned, 2>> keys(pool.size());
+    std::vector<bool> keyed(pool.size());
+    HeadKey key;
+    auto keysOf = [&](Interned head) {
+        if (!keyed[head.id])
+        {
+            for (auto m : {HeadMatch::Accents, HeadMatch::Letters})
+            {
+                auto k = key.make(head.view(), m);
+                if (!k)
+                    throw std::runtime_error("headword " + std::string{head.view()} +
+                                             " is too long to mark");
+                keys[head.id][(size_t)m] = pool.intern(*k);
+            }
+            keyed[head.id] = true;
+        }
+        return keys[head.id];
+    };
+
+    for (uint32_t f = 0; f < forms; ++f)
+    {
+        start_.push_back((uint32_t)answers_.size());
+        for (uint32_t row : morphs.rowsWithForm({f}))
+        {
+            Answer a{keysOf(morphs.heads()[row]), morphs.parseMasks()[row], row};
+            auto first = answers_.begin() + start_.back();
+            if (std::none_of(first, answers_.end(), [&](const Answer &b) {
+                    return b.keys == a.keys && b.parse == a.parse;
+                }))
+                answers_.push_back(a);
+        }
+    }
+    start_.push_back((uint32_t)answers_.size());
+}
+
+Grader::Grade Grader::grade(Interned form, Interned headKey, ParseMask parse,
+                            HeadMatch match) const
+{
+    Grade g;
+    if (form.id >= start_.size() - 1) // not a form in the store
+        return g;
+    for (uint32_t i = start_[form.id]; i < start_[form.id + 1]; ++i)
+    {
+        const Answer &a = answers_[i];
+        bool headOk = a.keys[(size_t)match] == headKey, parseOk = parse.covers(a.parse);
+        g.head |= headOk;
+        g.parse |= parseOk;
+        if (headOk && parseOk)
+        {
+            g.match = a.row;
+            break;
+        }
+    }
+    return g;
+}
+
+} // namespace gwr::gkqz
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "HeadKey.h"
+#include "MorphStore.h"
+#include "ParseMask.h"
+#include "StringPool.h"
+
+namespace gwr::gkqz
+{
+
+// Marks a (headword, parse) answer for an inflected form. The right answers for
+// every form are gathered once at startup, so marking needs no per-quiz setup:
+// it indexes a table by the form's handle and scans that form's few answers.
+// Headwords are compared by HeadKey, each answer's keys interned at startup.
+class Grader
+{
+  public:
+    // what an answer got right; match is the row it names, when it names one.
+    // headTooLong says the typed headword was over HeadKey::kMaxHead and so
+    // could not be marked; its parse still is.
+    struct Grade
+    {
+        bool head{false}, parse{false}, headTooLong{false};
+        uint32_t match{MorphStore::kNone};
+    };
+
+    // throws std::runtime_error if a headword of morphs is over HeadKey::kMaxHead
+    explicit Grader(const MorphStore &morphs);
+
+    // headKey is the StringPool::find() handle of a HeadKey made with the same
+    // match; parse is the student's, and may have features beyond the answer's
+    Grade grade(Interned form, Interned headKey, ParseMask parse,
+                HeadMatch match = HeadMatch::Accents) const;
+    // the same for an answer as typed: head in Beta Code or Greek, parse as tokens.
+    // Never allocates or writes the pool, so threads may share a Grader.
+    Grade grade(Interned form, std::string_view head, std::string_view parse,
+                HeadMatch match = HeadMatch::Accents) const
+    {
+        HeadKey key;
+        auto k = key.make(head, match);
+        // kMissing names no answer, so a headword with no key is never right
+        Grade g = grade(form, k ? StringPool::global().find(*k) : Interned{Interned::kMissing},
+                        ParseMask::compile(parse), match);
+        g.headTooLong = !k;
+        return g;
+    }
+    const MorphStore &morphs() const { return morphs_; }
+
+  private:
+    struct Answer
+    {
+        std::array<Interned, 2> keys; // of the headword, by HeadMatch
+        ParseMask parse;
+        uint32_t row;
+    };
+
+    const MorphStore &morphs_;
+    std::vector<uint32_t> start_; // form h's answers are answers_[start_[h], start_[h + 1])
+    std::vector<Answer> answers_; // each distinct (head key, parse) of a form once, in id order
+};
+
+} // namespace gwr::gkqz
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "HeadKey.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace gwr::gkqz
+{
+namespace
+{
+
+// the order marks take in a key, which is the order gkqz.db writes them in
+constexpr struct
+{
+    uint8_t flag;
+    char beta;
+} kMarks[]{
+    {BetaToken::kPsili, ')'},  {BetaToken::kDasia, '('},        {BetaToken::kDialytika, '+'},
+    {BetaToken::kOxia, '/'},   {BetaToken::kVaria, '\\'},       {BetaToken::kPerispomeni, '='},
+    {BetaToken::kYpogegrammeni, '|'},
+};
+
+// the flag of a mark's Beta Code character, 0 if c is not one
+constexpr uint8_t markFlag(char c)
+{
+    for (auto &m : kMarks)
+        if (m.beta == c)
+            return m.flag;
+    return 0;
+}
+
+} // namespace
+
+std::optional<std::string_view> HeadKey::make(std::string_view head, HeadMatch match)
+{
+    if (head.size() > kMaxHead)
+        return std::nullopt;
+    if (std::any_of(head.begin(), head.end(), [](char c) { return (unsigned char)c >= 0x80; }))
+        head = {beta_, Betacode::greek2beta(head, beta_, sizeof beta_)};
+
+    size_t count = BetacodeLexer::lex(head, tokens_), out{0};
+    uint8_t marks{0}; // of the letter last written, not yet written themselves
+    bool inLetter{false};
+    auto endLetter = [&] {
+        if (match == HeadMatch::Accents)
+            for (auto &m : kMarks)
+                if (marks & m.flag)
+                    key_[out++] = m.beta;
+        marks = 0;
+        inLetter = false;
+    };
+    for (size_t i = 0; i < count; ++i)
+    {
+        const BetaToken &t = tokens_[i];
+        uint8_t flag = markFlag(t.base);
+        // marks typed after a capital ("*A)/") come as tokens of their own
+        if (flag != 0 && inLetter)
+        {
+            marks |= flag;
+            continue;
+        }
+        endLetter();
+        // whitespace, homograph numbers ("a)/gw2") and marks with no letter
+        if (flag != 0 || (t.base >= '0' && t.base <= '9') || t.base == ' ' || t.base == '\t' ||
+            t.base == '\n' || t.base == '\r')
+            continue;
+        key_[out++] = t.base; // lower case, and sigma without its 1/2/3
+        if (t.isLetter())
+        {
+            marks = t.diacritics();
+            inLetter = true;
+        }
+    }
+    endLetter();
+    return std::string_view{key_, out};
+}
+
+} // namespace gwr::gkqz
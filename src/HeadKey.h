@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include "Betacode.h"
+#include "BetacodeLexer.h"
+
+namespace gwr::gkqz
+{
+
+// How much of a headword has to be right: Accents wants the breathings, accents,
+// diaeresis and iota subscript as well as the letters; Letters only the letters.
+enum class HeadMatch
+{
+    Accents,
+    Letters,
+};
+
+// Reduces a headword to a key that is the same for every way of typing it:
+// diacritics in any order or after a capital, '*' capitals, s/s1/s2/s3 sigmas
+// and Unicode Greek pasted in instead of Beta Code. The key is lower-case Beta
+// Code with each letter's marks in one order, e.g. "*)/Ai+dhs1" -> "a)/i+dhs",
+// or "aidhs" for HeadMatch::Letters; whitespace and homograph numbers such as
+// the 2 of "a)/gw2" are dropped. Works in fixed buffers, so it
+// never allocates and may be kept on the stack.
+class HeadKey
+{
+  public:
+    static constexpr size_t kMaxHead{64}; // bytes; a longer headword gets no key
+
+    // valid until the next call; nullopt if head is over kMaxHead
+    std::optional<std::string_view> make(std::string_view head, HeadMatch match);
+
+  private:
+    // the longest Beta Code a kMaxHead-byte headword can be, pasted Greek included;
+    // a key is never longer than its Beta Code
+    static constexpr size_t kMaxBeta{Betacode::betaCapacity(kMaxHead)};
+
+    char beta_[kMaxBeta];
+    BetaToken tokens_[kMaxBeta];
+    char key_[kMaxBeta];
+};
+
+} // namespace gwr::gkqz
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "MorphImage.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace gwr::gkqz
+{
+
+namespace
+{
+
+[[noreturn]] void corrupt(const char *what)
+{
+    throw std::runtime_error(std::string{"gkqz.img is damaged: "} + what);
+}
+
+} // namespace
+
+MorphImage::MorphImage(const void *data, size_t size)
+    : data_(static_cast<const unsigned char *>(data))
+{
+    if (size < sizeof(Header))
+        corrupt("too short");
+    std::memcpy(&header_, data_, sizeof(Header));
+    if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0)
+        corrupt("bad magic");
+
+    // Check every section and reference once here, so lookups need no checks.
+    auto fits = [size](uint32_t offset, uint64_t count, size_t width) {
+        return offset <= size && count * width <= size - offset;
+    };
+    const Header &h = header_;
+    if (!fits(h.rows, h.rowCount, sizeof(Row)) ||
+        !fits(h.lessons, (uint64_t)h.lessonCount + 1, 4) || !fits(h.pool, h.poolSize, 1))
+        corrupt("section out of bounds");
+
+    auto stringFits = [&](uint32_t at) {
+        return at < h.poolSize && data_[h.pool + at] < h.poolSize - at;
+    };
+    for (uint32_t i = 0; i < h.rowCount; ++i)
+    {
+        Row r;
+        std::memcpy(&r, data_ + h.rows + i * sizeof(Row), sizeof(Row));
+        for (uint32_t at : {r.inflected, r.head, r.parse, r.inflectedGk, r.headGk})
+            if (!stringFits(at))
+                corrupt("string out of bounds");
+    }
+    for (uint32_t l = 0; l < h.lessonCount; ++l)
+        if (load(h.lessons, l) > load(h.lessons, l + 1) || load(h.lessons, l + 1) > h.rowCount)
+            corrupt("bad lesson offsets");
+}
+
+uint32_t MorphImage::load(uint32_t offset, uint32_t index) const
+{
+    uint32_t v;
+    std::memcpy(&v, data_ + offset + (size_t)index * 4, 4);
+    return v;
+}
+
+std::string_view MorphImage::string(uint32_t poolOffset) const
+{
+    auto p = data_ + header_.pool + poolOffset;
+    return {reinterpret_cast<const char *>(p + 1), p[0]};
+}
+
+MorphRef MorphImage::row(uint32_t index) const
+{
+    Row r;
+    std::memcpy(&r, data_ + header_.rows + (size_t)index * sizeof(Row), sizeof(Row));
+    return {(int)r.id, (int)r.lesson, string(r.inflected), string(r.head), string(r.parse),
+            string(r.inflectedGk), string(r.headGk)};
+}
+
+uint32_t MorphImage::lessonBegin(int lesson) const
+{
+    if (lesson < 0 || (uint32_t)lesson >= header_.lessonCount)
+        return 0;
+    return load(header_.lessons, (uint32_t)lesson);
+}
+
+uint32_t MorphImage::lessonEnd(int lesson) const
+{
+    if (lesson < 0 || (uint32_t)lesson >= header_.lessonCount)
+        return 0;
+    return load(header_.lessons, (uint32_t)lesson + 1);
+}
+
+} // namespace gwr::gkqz
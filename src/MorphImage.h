@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace gwr::gkqz
+{
+
+// One newmorphs row as views into a MorphImage.
+struct MorphRef
+{
+    int id{0}, lesson{0};
+    std::string_view inflected, head, parse, inflectedGk, headGk;
+};
+
+// Reader for dbs/gkqz.img, the newmorphs table flattened by gkqz-imgbuild so the
+// app can quiz without sqlite. The image is used where it lies and never copied;
+// all values are little-endian uint32_t, read with memcpy so the image needs no
+// particular alignment. Only rows and lesson ranges are stored; MorphStore
+// builds its id, form and headword indexes over interned handles on load.
+//
+//   Header
+//   rows      rowCount x Row, sorted by (lesson, id), ids unique
+//   lessons   lessonCount + 1 row indices; lesson l is rows [lessons[l], lessons[l + 1])
+//   pool      strings, each one length byte then the bytes, no terminator
+class MorphImage
+{
+  public:
+    static constexpr char kMagic[8]{'G', 'K', 'Q', 'Z', 'I', 'M', 'G', '2'};
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t rowCount, lessonCount, poolSize;
+        uint32_t rows, lessons, pool; // byte offsets
+    };
+    // pool offsets of the strings, except id and lesson
+    struct Row
+    {
+        uint32_t id, lesson, inflected, head, parse, inflectedGk, headGk;
+    };
+    static_assert(std::endian::native == std::endian::little, "the image is little-endian");
+
+    // throws std::runtime_error if data is not a whole image
+    MorphImage(const void *data, size_t size);
+
+    size_t size() const { return header_.rowCount; }
+    MorphRef row(uint32_t index) const;
+
+    // rows [begin, end) are the ones in lesson; an empty range if there are none.
+    // Lessons are numbered from 0 up to lessonCount() - 1.
+    int lessonCount() const { return (int)header_.lessonCount; }
+    uint32_t lessonBegin(int lesson) const;
+    uint32_t lessonEnd(int lesson) const;
+
+  private:
+    uint32_t load(uint32_t offset, uint32_t index) const;
+    std::string_view string(uint32_t poolOffset) const;
+
+    const unsigned char *data_;
+    Header header_;
+};
+
+} // namespace gwr::gkqz
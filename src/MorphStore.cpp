@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "MorphStore.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace gwr::gkqz
+{
+
+MorphStore::MorphStore(const MorphImage &image)
+{
+    size_t n = image.size();
+    ids_.reserve(n);
+    lessons_.reserve(n);
+    for (auto column : {&heads_, &forms_, &parses_, &headsGk_, &formsGk_})
+        column->reserve(n);
+    parseMasks_.reserve(n);
+
+    auto &pool = StringPool::global();
+    int lastId{0};
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        MorphRef m = image.row(i);
+        if (m.lesson > 255)
+            throw std::runtime_error("lesson " + std::to_string(m.lesson) + " does not fit");
+        ids_.push_back(m.id);
+        lessons_.push_back((uint8_t)m.lesson);
+        heads_.push_back(pool.intern(m.head));
+        forms_.push_back(pool.intern(m.inflected));
+        parses_.push_back(pool.intern(m.parse));
+        parseMasks_.push_back(ParseMask::compile(m.parse));
+        headsGk_.push_back(pool.intern(m.headGk));
+        formsGk_.push_back(pool.intern(m.inflectedGk));
+        firstId_ = i == 0 ? m.id : std::min(firstId_, m.id);
+        lastId = i == 0 ? m.id : std::max(lastId, m.id);
+    }
+
+    // image rows are in (lesson, id) order, so each lesson is one run of them
+    for (int lesson = 0; lesson < image.lessonCount(); ++lesson)
+        lessonStart_.push_back(image.lessonBegin(lesson));
+    lessonStart_.push_back((uint32_t)n);
+
+    idSlots_.assign(n ? (size_t)(lastId - firstId_) + 1 : 0, kNone);
+    for (uint32_t i = 0; i < n; ++i)
+        idSlots_[ids_[i] - firstId_] = i;
+
+    byForm_.build(forms_, ids_);
+    byHead_.build(heads_, ids_);
+}
+
+void MorphStore::Index::build(std::span<const Interned> column, std::span<const int32_t> ids)
+{
+    // a counting sort on the handles, then id order within each group
+    uint32_t keys{0};
+    for (auto h : column)
+        keys = std::max(keys, h.id + 1);
+    start.assign(keys + 1, 0);
+    for (auto h : column)
+        ++start[h.id + 1];
+    for (uint32_t k = 0; k < keys; ++k)
+        start[k + 1] += start[k];
+    rowsByKey.resize(column.size());
+    std::vector<uint32_t> next(start.begin(), start.end() - 1);
+    for (uint32_t row = 0; row < column.size(); ++row)
+        rowsByKey[next[column[row].id]++] = row;
+    for (uint32_t k = 0; k < keys; ++k)
+        std::sort(rowsByKey.begin() + start[k], rowsByKey.begin() + start[k + 1],
+                  [&](uint32_t a, uint32_t b) { return ids[a] < ids[b]; });
+}
+
+std::span<const uint32_t> MorphStore::Index::rows(Interned key) const
+{
+    // handles interned after the store was built, and kMissing, have no group
+    if (start.empty() || key.id >= start.size() - 1)
+        return {};
+    return {rowsByKey.data() + start[key.id], start[key.id + 1] - start[key.id]};
+}
+
+dbEntry MorphStore::entry(uint32_t row) const
+{
+    dbEntry d;
+    d.id = ids_[row];
+    d.lesson = lessons_[row];
+    d.head = heads_[row];
+    d.inflected = forms_[row];
+    d.parse = parses_[row];
+    d.parseMask = parseMasks_[row];
+    d.headGk = headsGk_[row];
+    d.inflectedGk = formsGk_[row];
+    return d;
+}
+
+uint32_t MorphStore::findId(int id) const
+{
+    uint32_t slot = (uint32_t)id - (uint32_t)firstId_; // wraps to a huge slot below firstId_
+    return slot < idSlots_.size() ? idSlots_[slot] : kNone;
+}
+
+uint32_t MorphStore::lessonBegin(int lesson) const
+{
+    return lesson >= 0 && lesson < lessonCount() ? lessonStart_[lesson] : 0;
+}
+
+uint32_t MorphStore::lessonEnd(int lesson) const
+{
+    return lesson >= 0 && lesson < lessonCount() ? lessonStart_[lesson + 1] : 0;
+}
+
+} // namespace gwr::gkqz
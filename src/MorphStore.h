@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "MorphImage.h"
+#include "Utils.h"
+
+namespace gwr::gkqz
+{
+
+// newmorphs loaded once into one array per column, rows sorted by (lesson, id).
+// The arrays are small enough to stay in cache, and a filter over one column is
+// a plain loop the compiler can vectorize. Strings are StringPool handles, so
+// lookups by form or headword index arrays directly by handle, without hashing.
+class MorphStore
+{
+  public:
+    static constexpr uint32_t kNone{0xffffffff};
+
+    // throws std::runtime_error if a lesson does not fit in a uint8_t
+    explicit MorphStore(const MorphImage &image);
+
+    size_t size() const { return ids_.size(); }
+    dbEntry entry(uint32_t row) const;
+    // row with this id, kNone if there is none
+    uint32_t findId(int id) const;
+
+    // rows [begin, end) are the ones in lesson; an empty range if there are none
+    uint32_t lessonBegin(int lesson) const;
+    uint32_t lessonEnd(int lesson) const;
+    int lessonCount() const { return (int)lessonStart_.size() - 1; }
+
+    // rows with this inflected form or headword, in id order
+    std::span<const uint32_t> rowsWithForm(Interned form) const { return byForm_.rows(form); }
+    std::span<const uint32_t> rowsWithHead(Interned head) const { return byHead_.rows(head); }
+
+    // the columns themselves, one element per row
+    std::span<const int32_t> ids() const { return ids_; }
+    std::span<const uint8_t> lessons() const { return lessons_; }
+    std::span<const Interned> heads() const { return heads_; }
+    std::span<const Interned> forms() const { return forms_; }
+    std::span<const Interned> parses() const { return parses_; }
+    std::span<const ParseMask> parseMasks() const { return parseMasks_; }
+
+  private:
+    // rows grouped by a handle column: group h is rowsByKey[start[h], start[h + 1])
+    struct Index
+    {
+        std::vector<uint32_t> start, rowsByKey;
+        void build(std::span<const Interned> column, std::span<const int32_t> ids);
+        std::span<const uint32_t> rows(Interned key) const;
+    };
+
+    std::vector<int32_t> ids_;
+    std::vector<uint8_t> lessons_;
+    std::vector<Interned> heads_, forms_, parses_, headsGk_, formsGk_;
+    std::vector<ParseMask> parseMasks_;
+    std::vector<uint32_t> lessonStart_; // lesson l is rows [lessonStart_[l], lessonStart_[l + 1])
+    std::vector<uint32_t> idSlots_;     // row by id - firstId_, kNone where there is none
+    int firstId_{0};
+    Index byForm_, byHead_;
+};
+
+} // namespace gwr::gkqz
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace gwr::gkqz
+{
+
+// A parse such as "aor ind act 3rd sg" compiled to one bit per feature, packed as
+// a field per grammatical dimension (the vocabulary in help.html). Token order and
+// repeats drop out, so "ind aor act sg 3rd" compiles to the same mask, and grading
+// a parse is a couple of integer ops with nothing allocated.
+struct ParseMask
+{
+    struct Feature
+    {
+        std::string_view token;
+        uint32_t bit;
+    };
+    enum : uint32_t // first bit of each field
+    {
+        kTense = 0,   // pres imperf fut aor perf plup
+        kMood = 6,    // ind subj opt imperat inf part
+        kVoice = 12,  // act mid pass mp
+        kPerson = 16, // 1st 2nd 3rd
+        kNumber = 19, // sg dual pl
+        kCase = 22,   // nom gen dat acc voc
+        kGender = 27, // masc fem neut
+        kUnknown = 31 // a token outside the vocabulary
+    };
+    // in canonical order, which str() follows
+    static constexpr std::array<Feature, 30> kFeatures{{
+        {"pres", kTense},       {"imperf", kTense + 1}, {"fut", kTense + 2},
+        {"aor", kTense + 3},    {"perf", kTense + 4},   {"plup", kTense + 5},
+        {"ind", kMood},         {"subj", kMood + 1},    {"opt", kMood + 2},
+        {"imperat", kMood + 3}, {"inf", kMood + 4},     {"part", kMood + 5},
+        {"act", kVoice},        {"mid", kVoice + 1},    {"pass", kVoice + 2},
+        {"mp", kVoice + 3},     {"1st", kPerson},       {"2nd", kPerson + 1},
+        {"3rd", kPerson + 2},   {"sg", kNumber},        {"dual", kNumber + 1},
+        {"pl", kNumber + 2},    {"nom", kCase},         {"gen", kCase + 1},
+        {"dat", kCase + 2},     {"acc", kCase + 3},     {"voc", kCase + 4},
+        {"masc", kGender},      {"fem", kGender + 1},   {"neut", kGender + 2},
+    }};
+
+    uint32_t bits{0};
+
+    // Tokens are separated by spaces, tabs or commas; case and a trailing '.' are
+    // ignored, and any spelling in kSpellings counts as its feature. A token that
+    // is none of them sets kUnknown and, in the second form, is passed to
+    // onUnknown (e.g. to tell the student which word wasn't understood).
+    static constexpr ParseMask compile(std::string_view parse);
+    template <typename F> static constexpr ParseMask compile(std::string_view parse, F &&onUnknown);
+
+    // True if this parse (the student's) has every feature of db, the same test
+    // the old token-set comparison made: extra features are allowed, and a db parse
+    // with a token outside the vocabulary can't be matched.
+    constexpr bool covers(ParseMask db) const
+    {
+        return (db.bits & ~(bits & ~(1u << kUnknown))) == 0;
+    }
+
+    constexpr bool known() const { return (bits & (1u << kUnknown)) == 0; }
+
+    // the features in canonical order, e.g. "aor ind act 3rd sg"; drops unknown tokens
+    std::string str() const
+    {
+        std::string s;
+        for (auto &f : kFeatures)
+            if (bits & (1u << f.bit))
+                s.append(s.empty() ? "" : " ").append(f.token);
+        return s;
+    }
+
+    constexpr bool operator==(const ParseMask &) const = default;
+};
+
+namespace parse_detail
+{
+
+struct Spelling
+{
+    std::string_view token; // lower case, no trailing '.'
+    uint32_t bit;
+};
+
+// every kFeatures token, plus the abbreviations and full words students type for it;
+// ambiguous ones ("imp", "m", "p", "n") are left out so they read as unknown
+inline constexpr Spelling kSpellings[]{
+    {"pres", ParseMask::kTense},        {"present", ParseMask::kTense},
+    {"imperf", ParseMask::kTense + 1},  {"impf", ParseMask::kTense + 1},
+    {"imperfect", ParseMask::kTense + 1}, {"fut", ParseMask::kTense + 2},
+    {"future", ParseMask::kTense + 2},  {"aor", ParseMask::kTense + 3},
+    {"aorist", ParseMask::kTense + 3},  {"perf", ParseMask::kTense + 4},
+    {"pf", ParseMask::kTense + 4},      {"perfect", ParseMask::kTense + 4},
+    {"plup", ParseMask::kTense + 5},    {"plupf", ParseMask::kTense + 5},
+    {"pluperf", ParseMask::kTense + 5}, {"pluperfect", ParseMask::kTense + 5},
+    {"ind", ParseMask::kMood},          {"indic", ParseMask::kMood},
+    {"indicative", ParseMask::kMood},   {"subj", ParseMask::kMood + 1},
+    {"subjunctive", ParseMask::kMood + 1}, {"opt", ParseMask::kMood + 2},
+    {"optative", ParseMask::kMood + 2}, {"imperat", ParseMask::kMood + 3},
+    {"impv", ParseMask::kMood + 3},     {"imptv", ParseMask::kMood + 3},
+    {"imperative", ParseMask::kMood + 3}, {"inf", ParseMask::kMood + 4},
+    {"infin", ParseMask::kMood + 4},    {"infinitive", ParseMask::kMood + 4},
+    {"part", ParseMask::kMood + 5},     {"ptcp", ParseMask::kMood + 5},
+    {"ptc", ParseMask::kMood + 5},      {"pple", ParseMask::kMood + 5},
+    {"participle", ParseMask::kMood + 5}, {"act", ParseMask::kVoice},
+    {"active", ParseMask::kVoice},      {"mid", ParseMask::kVoice + 1},
+    {"middle", ParseMask::kVoice + 1},  {"pass", ParseMask::kVoice + 2},
+    {"passive", ParseMask::kVoice + 2}, {"mp", ParseMask::kVoice + 3},
+    {"m/p", ParseMask::kVoice + 3},     {"m.p", ParseMask::kVoice + 3},
+    {"mid/pass", ParseMask::kVoice + 3}, {"mid-pass", ParseMask::kVoice + 3},
+    {"mediopassive", ParseMask::kVoice + 3}, {"1st", ParseMask::kPerson},
+    {"1", ParseMask::kPerson},          {"first", ParseMask::kPerson},
+    {"2nd", ParseMask::kPerson + 1},    {"2", ParseMask::kPerson + 1},
+    {"second", ParseMask::kPerson + 1}, {"3rd", ParseMask::kPerson + 2},
+    {"3", ParseMask::kPerson + 2},      {"third", ParseMask::kPerson + 2},
+    {"sg", ParseMask::kNumber},         {"s", ParseMask::kNumber},
+    {"sing", ParseMask::kNumber},       {"singular", ParseMask::kNumber},
+    {"dual", ParseMask::kNumber + 1},   {"du", ParseMask::kNumber + 1},
+    {"pl", ParseMask::kNumber + 2},     {"plur", ParseMask::kNumber + 2},
+    {"plural", ParseMask::kNumber + 2}, {"nom", ParseMask::kCase},
+    {"nominative", ParseMask::kCase},   {"gen", ParseMask::kCase + 1},
+    {"genitive", ParseMask::kCase + 1}, {"dat", ParseMask::kCase + 2},
+    {"dative", ParseMask::kCase + 2},   {"acc", ParseMask::kCase + 3},
+    {"accusative", ParseMask::kCase + 3}, {"voc", ParseMask::kCase + 4},
+    {"vocative", ParseMask::kCase + 4}, {"masc", ParseMask::kGender},
+    {"masculine", ParseMask::kGender},  {"fem", ParseMask::kGender + 1},
+    {"feminine", ParseMask::kGender + 1}, {"neut", ParseMask::kGender + 2},
+    {"neuter", ParseMask::kGender + 2},
+};
+inline constexpr size_t kMaxSpelling{12}; // longer tokens are unknown without a lookup
+
+// A perfect hash of kSpellings, found at compile time: every spelling lands in its
+// own slot, so a lookup is one hash, one load and one compare.
+struct SpellingTable
+{
+    static constexpr uint32_t kSlotBits{10};
+    uint32_t seed;
+    std::array<uint8_t, 1u << kSlotBits> slot; // 1 + index into kSpellings, 0 if empty
+
+    static constexpr uint32_t hash(std::string_view token, uint32_t seed)
+    {
+        uint32_t h{2166136261u ^ seed};
+        for (unsigned char c : token)
+            h = (h ^ c) * 16777619u;
+        return h >> (32 - kSlotBits);
+    }
+};
+
+constexpr SpellingTable buildSpellingTable()
+{
+    static_assert(std::size(kSpellings) < 255);
+    for (auto &a : kSpellings)
+    {
+        if (a.token.size() > kMaxSpelling)
+            throw "spelling longer than kMaxSpelling";
+        for (auto &b : kSpellings)
+            if (&a != &b && a.token == b.token)
+                throw "spelling listed twice";
+    }
+    for (auto &f : ParseMask::kFeatures)
+        if (std::find_if(std::begin(kSpellings), std::end(kSpellings),
+                         [&](auto &s) { return s.token == f.token; }) == std::end(kSpellings))
+            throw "a kFeatures token has no spelling";
+    for (uint32_t seed = 0; seed < 100000; ++seed)
+    {
+        SpellingTable t{seed, {}};
+        bool collided{false};
+        for (size_t i = 0; i < std::size(kSpellings) && !collided; ++i)
+        {
+            auto &slot = t.slot[SpellingTable::hash(kSpellings[i].token, seed)];
+            collided = slot != 0;
+            slot = (uint8_t)(i + 1);
+        }
+        if (!collided)
+            return t;
+    }
+    throw "no perfect hash seed; grow kSlotBits";
+}
+
+inline constexpr SpellingTable kSpellingTable = buildSpellingTable();
+
+} // namespace parse_detail
+
+template <typename F>
+constexpr ParseMask ParseMask::compile(std::string_view parse, F &&onUnknown)
+{
+    ParseMask m;
+    while (!parse.empty())
+    {
+        size_t end = parse.find_first_of(" \t,");
+        std::string_view token = parse.substr(0, end);
+        parse.remove_prefix(end == std::string_view::npos ? parse.size() : end + 1);
+        std::string_view key = token;
+        if (!key.empty() && key.back() == '.')
+            key.remove_suffix(1);
+        if (key.empty())
+            continue;
+
+        uint32_t bit{kUnknown};
+        if (key.size() <= parse_detail::kMaxSpelling)
+        {
+            char lower[parse_detail::kMaxSpelling]{};
+            for (size_t i = 0; i < key.size(); ++i)
+                lower[i] = key[i] >= 'A' && key[i] <= 'Z' ? (char)(key[i] + 32) : key[i];
+            std::string_view folded{lower, key.size()};
+            auto &table = parse_detail::kSpellingTable;
+            uint8_t slot = table.slot[table.hash(folded, table.seed)];
+            if (slot != 0 && parse_detail::kSpellings[slot - 1].token == folded)
+                bit = parse_detail::kSpellings[slot - 1].bit;
+        }
+        if (bit == kUnknown)
+            onUnknown(token);
+        m.bits |= 1u << bit;
+    }
+    return m;
+}
+
+constexpr ParseMask ParseMask::compile(std::string_view parse)
+{
+    return compile(parse, [](std::string_view) {});
+}
+
+static_assert(ParseMask::compile("aor ind act 3rd sg") == ParseMask::compile("sg 3rd act  ind aor"));
+static_assert(ParseMask::compile("pres act part masc nom sg aor").covers(
+    ParseMask::compile("pres act part masc nom sg")));
+static_assert(!ParseMask::compile("pres act part masc nom").covers(
+    ParseMask::compile("pres act part masc nom sg")));
+static_assert(ParseMask::compile("aor ind act 3rd sg xyz").covers(ParseMask::compile("aor")));
+static_assert(!ParseMask::compile("xyz").covers(ParseMask::compile("xyz")));
+static_assert(ParseMask::compile("Impf m/p 3 s.") == ParseMask::compile("imperf mp 3rd sg"));
+static_assert(ParseMask::compile("aor,ind,act") == ParseMask::compile("aor ind act"));
+static_assert(!ParseMask::compile("aorr").known());
+
+} // namespace gwr::gkqz
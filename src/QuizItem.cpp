@@ -27,7 +27,7 @@ namespace gwr::gkqz
 VISAGE_THEME_COLOR(WRONG, 0xff991212);
 VISAGE_THEME_COLOR(RIGHT, 0xff129912);
 
-QuizItem::QuizItem()
+QuizItem::QuizItem(const Grader &grader) : grader_(grader)
 {
     layout().setFlex(true);
     layout().setFlexRows(false);
@@ -79,7 +79,7 @@ QuizItem::QuizItem()
 
     headwordUser.onTextChange() += [&]() {
         // mirror betacode with Greek
-        headwordDb.setText(bc::beta2greek(headwordUser.text().toUtf8()));
+        headwordDb.setText(mirror_.update(headwordUser.text().toUtf8()));
     };
 
     headwordDb.layout().setDimensions(100_vw, 50_vh);
@@ -90,8 +90,6 @@ QuizItem::QuizItem()
     promptDb.outline = true;
     headwordDb.outline = true;
     parseDb.outline = true;
-    userForm.id = 0;
-    userForm.lesson = 0;
     userForm.head = "0";
     userForm.inflected = "0";
     userForm.parse = "0";
@@ -102,42 +100,32 @@ void QuizItem::draw(visage::Canvas &canvas) { canvas.setColor(0xff000000); }
 
 void QuizItem::check()
 {
-    int idx{0};
-    headIsCorrect = false;
-    parseIsCorrect = false;
-    for (auto &dbForm : dbForms)
-    {
-        bool headC{false}, parseC{false};
-        if (userForm.head == dbForm.head)
-        {
-            headC = true;
-            headIsCorrect = true;
-        }
-        if (compareParses(userForm.parse, dbForm.parse))
-        {
-            parseC = true;
-            parseIsCorrect = true;
-        }
-        if (parseC && headC)
-        {
-            idxOfCorrectParse = idx;
-            headIsCorrect = true;
-            parseIsCorrect = true;
-            return;
-        }
-        ++idx;
-    }
+    grade_ = grader_.grade(dbForm.inflected, userForm.head, userForm.parse, headMatch);
+    // the words the grader could not read, so show() can name them
+    unknown_.clear();
+    ParseMask::compile(userForm.parse, [&](std::string_view token) {
+        if (!unknown_.empty())
+            unknown_ += ", ";
+        unknown_ += token;
+    });
+    headIsCorrect = grade_.head;
+    parseIsCorrect = grade_.parse;
 }
 
 void QuizItem::show()
 {
-    int idx{0};
-    if (parseIsCorrect)
-        idx = idxOfCorrectParse;
-    auto &str = dbForms[idx].head;
-    headwordDb.setText(bc::beta2greek(str));
+    // the answer the student matched, else the prompt's own
+    dbEntry shown = grade_.match == MorphStore::kNone ? dbForm
+                                                      : grader_.morphs().entry(grade_.match);
+    std::string head{shown.headGk.view()};
+    if (grade_.headTooLong)
+        head += " (yours is too long to mark)";
+    headwordDb.setText(head);
     headwordUser.setText(bc::beta2greek(userForm.head));
-    parseDb.setText(dbForms[idx].parse);
+    std::string parse{shown.parse.view()};
+    if (!unknown_.empty())
+        parse += " (unknown: " + unknown_ + ")";
+    parseDb.setText(parse);
     redraw();
 }
 
@@ -193,43 +181,15 @@ void QuizItem::clearAll()
     parseUser.clear();
     headwordDb.setText("");
     parseDb.setText("");
+    mirror_.clear();
     headwordUser.setBackgroundColorId(visage::TextEditor::TextEditorBackground);
     parseUser.setBackgroundColorId(visage::TextEditor::TextEditorBackground);
     headIsCorrect = false;
     parseIsCorrect = false;
+    grade_ = {};
+    unknown_.clear();
     redraw();
     // set colors
 }
 
-bool QuizItem::compareParses(std::string &userParse, std::string &dbParse)
-{
-    int matches{0};
-    auto userParts = split(userParse, ' ');
-    auto dbParts = split(dbParse, ' ');
-    for (auto &dbPart : dbParts)
-    {
-        if (userParts.contains(dbPart))
-            ++matches;
-    }
-    auto m = (matches == dbParts.size());
-    return m;
-}
-
-std::set<std::string> QuizItem::split(std::string &str, char delimiter)
-{
-    std::set<std::string> tokens;
-    size_t start = 0;
-    size_t end = str.find(delimiter);
-
-    while (end != std::string::npos)
-    {
-        tokens.insert(str.substr(start, end - start));
-        start = end + 1;
-        end = str.find(delimiter, start);
-    }
-
-    tokens.insert(str.substr(start));
-    return tokens;
-}
-
 } // namespace gwr::gkqz
\ No newline at end of file
@@ -20,10 +20,11 @@
 #include "embedded/example_fonts.h"
 #include "Label.h"
 #include "Betacode.h"
+#include "BetacodeMirror.h"
 #include <visage_widgets/text_editor.h>
 #include <visage_utils/dimension.h>
 #include <visage_graphics/theme.h>
-#include <set>
+#include "Grader.h"
 #include "Utils.h"
 
 namespace gwr::gkqz
@@ -35,11 +36,9 @@ class QuizItem : public visage::Frame
     std::string name_{""};
     visage::Font fontEn{20, visage::fonts::Lato_Regular_ttf};
     visage::Font fontGk{20, resources::fonts::GFSDidot_Regular_ttf};
-    QuizItem();
+    explicit QuizItem(const Grader &grader);
     void draw(visage::Canvas &canvas);
-    bool compareParses(std::string &userParse, std::string &dbParse);
     void clearAll();
-    std::set<std::string> split(std::string &str, char delimiter);
     void check();       // is head correct, is parse?
     void readEntries(); // load input into fields
     void color();       // color entries by correctness
@@ -49,13 +48,17 @@ class QuizItem : public visage::Frame
     void grn(visage::TextEditor *e);
     void blk(visage::TextEditor *e);
     bool headIsCorrect{false}, parseIsCorrect{false};
-    size_t idxOfCorrectParse{0};
-    dbEntry userForm;             // full entry data for one question
-    std::vector<dbEntry> dbForms; // for each user form, check for (legal) alts, push them in
+    HeadMatch headMatch{HeadMatch::Accents}; // how strictly check() marks the headword
+    userEntry userForm;           // full entry data for one question
+    dbEntry dbForm;               // the prompt; grader_ knows its other parses
 
     visage::Frame prompt, headword, parse;
     Label promptDb, headwordDb, parseDb;
     visage::TextEditor headwordUser, parseUser; // user entry
+    BetacodeMirror mirror_;                     // Greek mirror of headwordUser
+    const Grader &grader_;
+    Grader::Grade grade_;
+    std::string unknown_; // the student's parse words that are no feature, comma-separated
 };
 
 } // namespace gwr::gkqz
\ No newline at end of file
@@ -68,9 +68,6 @@ QuizRevItem::QuizRevItem()
     inflectedEditor.layout().setMargin(1_vh);
     inflectedEditor.setDefaultText("inflected...");
     inflectedEditor.setTextFieldEntry();
-    inflectedEditor.onTextChange() = [&]() {
-        inflectedDb.setText(bc::beta2greek(inflectedEditor.text().toUtf8()));
-    };
 
     headwordDb.setFont(fontGk.withSize(35.f));
     headwordDb.layout().setDimensions(100_vw, 100_vh);
@@ -79,7 +76,7 @@ QuizRevItem::QuizRevItem()
 
     inflectedEditor.onTextChange() += [&]() {
         // mirror betacode with Greek
-        inflectedDb.setText(bc::beta2greek(inflectedEditor.text().toUtf8()));
+        inflectedDb.setText(mirror_.update(inflectedEditor.text().toUtf8()));
     };
 
     headwordDb.layout().setDimensions(100_vw, 100_vh);
@@ -91,8 +88,6 @@ QuizRevItem::QuizRevItem()
     inflectedDb.outline = true;
     headwordDb.outline = true;
     parseDb.outline = true;
-    userForm.id = 0;
-    userForm.lesson = 0;
     userForm.head = "0";
     userForm.inflected = "0";
     userForm.parse = "0";
@@ -103,7 +98,7 @@ void QuizRevItem::draw(visage::Canvas &canvas) { canvas.setColor(0xff000000); }
 
 void QuizRevItem::check()
 {
-    if (dbForm.inflected == userForm.inflected)
+    if (dbForm.inflected == gkqz::StringPool::global().find(userForm.inflected))
         inflectedIsCorrect = true;
     else
         inflectedIsCorrect = false;
@@ -112,7 +107,7 @@ void QuizRevItem::check()
 void QuizRevItem::show()
 {
     inflectedEditor.setText(bc::beta2greek(inflectedEditor.text().toUtf8()));
-    inflectedDb.setText(bc::beta2greek(dbForm.inflected));
+    inflectedDb.setText(std::string{dbForm.inflectedGk.view()});
 }
 
 void QuizRevItem::mark()
@@ -156,6 +151,7 @@ void QuizRevItem::color()
 void QuizRevItem::clearAll()
 {
     inflectedEditor.clear();
+    mirror_.clear();
     headwordDb.setText("");
     parseDb.setText("");
     inflectedEditor.setBackgroundColorId(visage::TextEditor::TextEditorBackground);
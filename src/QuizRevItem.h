@@ -20,6 +20,7 @@
 #include "embedded/example_fonts.h"
 #include "Label.h"
 #include "Betacode.h"
+#include "BetacodeMirror.h"
 #include "Utils.h"
 #include <visage_widgets/text_editor.h>
 #include <visage_utils/dimension.h>
@@ -51,7 +52,9 @@ class QuizRevItem : public visage::Frame
     visage::Frame prompt, headword, parse;
     Label inflectedDb, headwordDb, parseDb;
     visage::TextEditor inflectedEditor; // user entry
-    dbEntry userForm, dbForm;
+    BetacodeMirror mirror_;             // Greek mirror of inflectedEditor
+    userEntry userForm;
+    dbEntry dbForm;
 };
 
 } // namespace gwr::gkrv
\ No newline at end of file
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "QuizSampler.h"
+#include <algorithm>
+#include "DbQueries.h"
+
+namespace gwr::gkqz
+{
+
+QuizSampler::QuizSampler(const MorphStore &morphs)
+{
+    // the store keeps its rows in (lesson, id) order already
+    ids_.assign(morphs.ids().begin(), morphs.ids().end());
+    for (int lesson = 0; lesson < morphs.lessonCount(); ++lesson)
+        ends_.push_back(morphs.lessonEnd(lesson));
+}
+
+#ifdef GKQZ_WITH_SQLITE
+QuizSampler::QuizSampler(SQLite::Database &db)
+{
+    SQLite::Statement st{db, DbQueries::kLessonOrder};
+    while (st.executeStep())
+    {
+        int lesson = std::max(st.getColumn(1).getInt(), 0);
+        if ((size_t)lesson >= ends_.size())
+            ends_.resize(lesson + 1, (uint32_t)ids_.size());
+        ids_.push_back(st.getColumn(0).getInt());
+        ++ends_[lesson];
+    }
+}
+#endif
+
+std::vector<int> QuizSampler::sample(int lesson, size_t count)
+{
+    std::vector<int> picks;
+    if (lesson < 0 || ends_.empty())
+        return picks;
+    size_t n = ends_[std::min((size_t)lesson, ends_.size() - 1)];
+    count = std::min(count, n);
+    picks.reserve(count);
+
+    // Floyd's algorithm: count distinct indices into [0, n) with count draws
+    for (size_t j = n - count; j < n; ++j)
+    {
+        size_t t = std::uniform_int_distribution<size_t>{0, j}(rng_);
+        int id = ids_[t];
+        if (std::find(picks.begin(), picks.end(), id) != picks.end())
+            id = ids_[j];
+        picks.push_back(id);
+    }
+    // Floyd's picks are a uniform set but not in uniform order
+    std::shuffle(picks.begin(), picks.end(), rng_);
+    return picks;
+}
+
+} // namespace gwr::gkqz
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#ifdef GKQZ_WITH_SQLITE
+#include <SQLiteCpp/SQLiteCpp.h>
+#endif
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "MorphStore.h"
+
+namespace gwr::gkqz
+{
+
+// Draws quiz questions without asking the db to shuffle the table. Row ids are
+// loaded once, ordered by lesson, with a prefix count per lesson, so the rows
+// for "lesson <= n" are the first ends_[n] ids and a quiz is a few random picks.
+class QuizSampler
+{
+  public:
+    explicit QuizSampler(const MorphStore &morphs);
+#ifdef GKQZ_WITH_SQLITE
+    explicit QuizSampler(SQLite::Database &db);
+#endif
+    // up to count distinct newmorphs ids with lesson <= lesson, in random order
+    std::vector<int> sample(int lesson, size_t count);
+
+  private:
+    std::vector<int> ids_;       // every row id, grouped by lesson
+    std::vector<uint32_t> ends_; // ends_[l]: number of rows with lesson <= l
+    std::mt19937 rng_{std::random_device{}()};
+};
+
+} // namespace gwr::gkqz
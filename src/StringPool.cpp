@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#include "StringPool.h"
+
+namespace gwr::gkqz
+{
+
+StringPool &StringPool::global()
+{
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::StringPool() { intern(""); } // id 0, the default Interned
+
+Interned StringPool::intern(std::string_view s)
+{
+    if (auto it = ids_.find(s); it != ids_.end())
+        return {it->second};
+    uint32_t id = (uint32_t)views_.size();
+    views_.push_back(strings_.emplace_back(s));
+    ids_.emplace(views_.back(), id);
+    return {id};
+}
+
+Interned StringPool::find(std::string_view s) const
+{
+    auto it = ids_.find(s);
+    return {it == ids_.end() ? Interned::kMissing : it->second};
+}
+
+std::string_view StringPool::view(Interned s) const
+{
+    return s.id < views_.size() ? views_[s.id] : std::string_view{};
+}
+
+} // namespace gwr::gkqz
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gwr::gkqz
+{
+
+// A string in the StringPool, by number. Equal handles mean equal strings, so
+// comparing two is one integer compare; the default handle is "".
+struct Interned
+{
+    static constexpr uint32_t kMissing{0xffffffff}; // find() of a string never interned
+
+    uint32_t id{0};
+    std::string_view view() const; // for display; valid as long as the pool
+    bool operator==(const Interned &) const = default;
+};
+
+// Each distinct db string stored once, for the life of the program. Only the UI
+// thread interns; views and compares are safe from anywhere once a quiz is built.
+class StringPool
+{
+  public:
+    static StringPool &global();
+
+    // allocates only the first time a string is seen
+    Interned intern(std::string_view s);
+    // never allocates; Interned::kMissing if s was never interned, which equals no
+    // handle but itself
+    Interned find(std::string_view s) const;
+    std::string_view view(Interned s) const;
+    size_t size() const { return views_.size(); }
+
+  private:
+    StringPool();
+    std::deque<std::string> strings_; // a deque never moves its elements
+    std::vector<std::string_view> views_;
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+
+inline std::string_view Interned::view() const { return StringPool::global().view(*this); }
+
+} // namespace gwr::gkqz
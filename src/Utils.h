@@ -17,17 +17,24 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
+#include "ParseMask.h"
+#include "StringPool.h"
 
+// One db row. The strings are interned, so entries copy like plain structs and
+// compare field by field as integers; call view() on a field to display it.
 typedef struct dbEntry
 {
     int id{0}, lesson{0};
+    gwr::gkqz::Interned head, inflected, parse;
+    gwr::gkqz::Interned headGk, inflectedGk; // precomputed Unicode from the db
+    gwr::gkqz::ParseMask parseMask;          // parse, compiled for grading
+    void clear() { *this = {}; }
+} dbEntry;
+static_assert(std::is_trivially_copyable_v<dbEntry>);
+
+// What the student typed for one question, which need not be any db string.
+typedef struct userEntry
+{
     std::string head{""}, inflected{""}, parse{""};
-    void clear()
-    {
-        head.clear();
-        inflected.clear();
-        parse.clear();
-        id = 0;
-        lesson = 0;
-    }
-} dbEntry;
\ No newline at end of file
+} userEntry;
@@ -0,0 +1,20 @@
+# Runs gkqz-grade on answers.tsv and fails unless it writes exactly EXPECTED:
+#
+#   cmake -DGRADE=<gkqz-grade> -DIMG=<gkqz.img> -DEXPECTED=<jsonl> [-DFLAGS=-l] -P check.cmake
+#
+# answers.tsv has an ambiguous form (a)/rxonta, of a)/rxwn and of a)/rxw),
+# marks typed in either order, capitals, s/s1/s2/s3, pasted and decomposed
+# Greek, an unknown id, a parse typo and a headword over HeadKey::kMaxHead.
+# accents.jsonl is what it grades to by default, letters.jsonl with -l.
+
+execute_process(COMMAND ${GRADE} ${FLAGS} ${IMG}
+  INPUT_FILE ${CMAKE_CURRENT_LIST_DIR}/answers.tsv
+  OUTPUT_VARIABLE got
+  RESULT_VARIABLE status)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "gkqz-grade failed: ${status}")
+endif()
+file(READ ${EXPECTED} want)
+if(NOT got STREQUAL want)
+    message(FATAL_ERROR "gkqz-grade ${FLAGS} wrote\n${got}\ninstead of ${EXPECTED}:\n${want}")
+endif()
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+
+// Streams text between Betacode and Greek UTF-8, stdin to stdout.
+//
+//   gkqz-conv [--to-beta | --tonos] < in > out
+//
+// --tonos writes accented letters from U+0370..U+03FF where Unicode has them,
+// instead of the Greek Extended oxia forms the app uses.
+//
+// Input is read in fixed chunks and each chunk is converted up to its last
+// whitespace byte; the tail is carried over to the next chunk. A polytonic
+// character (letter plus marks, or s/s1/s2) or a UTF-8 sequence never spans
+// whitespace, so the output matches converting the whole input at once, in
+// constant memory. The Betacode quote state is carried across chunks too.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include "Betacode.h"
+
+namespace
+{
+
+constexpr size_t kChunk = 1 << 20;
+
+bool toBeta{false};
+Accents accents{Accents::Oxia};
+int quoteState{0};
+std::vector<char> out;
+
+void fail(const char *what)
+{
+    std::perror(what);
+    std::exit(1);
+}
+
+void write(const char *s, size_t n)
+{
+    if (n > 0 && std::fwrite(s, 1, n, stdout) != n)
+        fail("gkqz-conv: write");
+}
+
+// ub_beta2greek stops at a NUL byte, so NULs are passed through between pieces
+void convertBeta(std::string_view beta)
+{
+    while (!beta.empty())
+    {
+        size_t piece = std::min(beta.find('\0'), beta.size());
+        int n = ub_beta2greek_r(beta.data(), (int)piece, out.data(), (int)out.size(), &quoteState,
+                                (int)accents);
+        write(out.data(), (size_t)n);
+        if (piece < beta.size())
+        {
+            write("", 1);
+            ++piece;
+        }
+        beta.remove_prefix(piece);
+    }
+}
+
+void convert(std::string_view in)
+{
+    if (toBeta)
+        write(out.data(), Betacode::greek2beta(in, out.data(), out.size()));
+    else
+        convertBeta(in);
+}
+
+// length of the prefix that can be converted without seeing what follows it
+size_t safePrefix(const char *s, size_t n)
+{
+    for (size_t i = n; i > 0; --i)
+    {
+        char c = s[i - 1];
+        if (c == ' ' || c == '\n' || c == '\t' || c == '\r')
+            return i;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc == 2 && std::strcmp(argv[1], "--to-beta") == 0)
+        toBeta = true;
+    else if (argc == 2 && std::strcmp(argv[1], "--tonos") == 0)
+        accents = Accents::Tonos;
+    else if (argc != 1)
+    {
+        std::fprintf(stderr, "usage: gkqz-conv [--to-beta | --tonos] < in > out\n");
+        return 2;
+    }
+
+    std::vector<char> in(kChunk);
+    out.resize(toBeta ? Betacode::betaCapacity(kChunk) : Betacode::greekCapacity(kChunk));
+    size_t carry{0};
+    for (;;)
+    {
+        size_t got = std::fread(in.data() + carry, 1, in.size() - carry, stdin);
+        size_t n = carry + got;
+        if (got == 0)
+        {
+            if (std::ferror(stdin))
+                fail("gkqz-conv: read");
+            convert({in.data(), n});
+            break;
+        }
+        size_t ready = safePrefix(in.data(), n);
+        if (ready == 0 && n == in.size())
+            ready = n; // a whole chunk without whitespace; convert it to keep memory bounded
+        convert({in.data(), ready});
+        carry = n - ready;
+        std::memmove(in.data(), in.data() + ready, carry);
+    }
+    if (std::fflush(stdout) != 0)
+        fail("gkqz-conv: write");
+    return 0;
+}
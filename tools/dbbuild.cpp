@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+// Builds the embedded quiz database from the authoring database.
+//
+//   gkqz-dbbuild [--tonos] dbs/dbs.sqlite3 dbs/gkqz.db
+//
+// Run it after editing dbs.sqlite3, then gkqz-imgbuild, and commit both
+// outputs; the app build embeds whatever is in the tree. The committed
+// database uses oxia forms; --tonos builds one for fonts that want the U+03xx
+// tonos letters instead.
+//
+// The output is linked into the web app, so it holds only what the app
+// needs: the newmorphs table and the indexes behind its lookups, written
+// at whichever page size gives the smallest file. CMake checks the result
+// against GKQZ_DB_BUDGET. Every statement in DbQueries is planned against the
+// finished db, and the build fails if one would scan the table or sort in a
+// temporary b-tree.
+
+#include <sqlite3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Betacode.h"
+#include "DbQueries.h"
+
+namespace
+{
+
+void fail(sqlite3 *db, const char *what)
+{
+    std::fprintf(stderr, "gkqz-dbbuild: %s: %s\n", what, db ? sqlite3_errmsg(db) : "");
+    std::exit(1);
+}
+
+void exec(sqlite3 *db, const char *sql)
+{
+    char *err{nullptr};
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &err) != SQLITE_OK)
+    {
+        std::fprintf(stderr, "gkqz-dbbuild: %s\n  in: %s\n", err, sql);
+        std::exit(1);
+    }
+}
+
+sqlite3_int64 pragmaInt(sqlite3 *db, const char *sql)
+{
+    sqlite3_stmt *st{nullptr};
+    if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) != SQLITE_OK)
+        fail(db, sql);
+    sqlite3_int64 v = sqlite3_step(st) == SQLITE_ROW ? sqlite3_column_int64(st, 0) : 0;
+    sqlite3_finalize(st);
+    return v;
+}
+
+// Copies src.newmorphs into newmorphs in id order, with the Greek display forms
+// transcoded in one BetacodeArena batch rather than a call per value.
+void copyRows(sqlite3 *db, Accents accents)
+{
+    struct Row
+    {
+        sqlite3_int64 id, lesson;
+        std::string inflected, head, parse;
+    };
+    std::vector<Row> rows;
+    sqlite3_stmt *st{nullptr};
+    if (sqlite3_prepare_v2(db,
+                           "select id, inflected, head, parse, lesson from src.newmorphs "
+                           "order by id",
+                           -1, &st, nullptr) != SQLITE_OK)
+        fail(db, "select rows");
+    auto text = [&](int col) {
+        auto s = reinterpret_cast<const char *>(sqlite3_column_text(st, col));
+        if (!s)
+            fail(db, "null inflected, head or parse in src.newmorphs");
+        return std::string{s, (size_t)sqlite3_column_bytes(st, col)};
+    };
+    int rc;
+    while ((rc = sqlite3_step(st)) == SQLITE_ROW)
+        rows.push_back({sqlite3_column_int64(st, 0), sqlite3_column_int64(st, 4), text(1),
+                        text(2), text(3)});
+    if (rc != SQLITE_DONE)
+        fail(db, "select rows");
+    sqlite3_finalize(st);
+
+    // inflected and head of each row, in row order
+    std::vector<std::string_view> beta;
+    beta.reserve(2 * rows.size());
+    for (auto &r : rows)
+    {
+        beta.push_back(r.inflected);
+        beta.push_back(r.head);
+    }
+    BetacodeArena arena;
+    auto gk = arena.beta2greek(beta, accents);
+
+    if (sqlite3_prepare_v2(db,
+                           "insert into newmorphs (id, inflected, head, parse, lesson, "
+                           "inflected_gk, head_gk) values (?, ?, ?, ?, ?, ?, ?)",
+                           -1, &st, nullptr) != SQLITE_OK)
+        fail(db, "insert rows");
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        auto &r = rows[i];
+        sqlite3_bind_int64(st, 1, r.id);
+        sqlite3_bind_text(st, 2, r.inflected.data(), (int)r.inflected.size(), SQLITE_STATIC);
+        sqlite3_bind_text(st, 3, r.head.data(), (int)r.head.size(), SQLITE_STATIC);
+        sqlite3_bind_text(st, 4, r.parse.data(), (int)r.parse.size(), SQLITE_STATIC);
+        sqlite3_bind_int64(st, 5, r.lesson);
+        sqlite3_bind_text(st, 6, gk[2 * i].data(), (int)gk[2 * i].size(), SQLITE_STATIC);
+        sqlite3_bind_text(st, 7, gk[2 * i + 1].data(), (int)gk[2 * i + 1].size(), SQLITE_STATIC);
+        if (sqlite3_step(st) != SQLITE_DONE)
+            fail(db, "insert rows");
+        sqlite3_reset(st);
+    }
+    sqlite3_finalize(st);
+}
+
+// Rewrites db at every legal page size and keeps the smallest. Small pages waste
+// less in half-full leaves, large ones less on per-page headers and interior
+// pages; which wins depends on the rows, so measure rather than guess.
+int compact(sqlite3 *db)
+{
+    int best{0};
+    sqlite3_int64 bestBytes{0};
+    for (int size : {512, 1024, 2048, 4096, 8192, 16384, 32768, 65536})
+    {
+        std::string sql = "pragma page_size = " + std::to_string(size);
+        exec(db, sql.c_str());
+        exec(db, "vacuum");
+        auto bytes = pragmaInt(db, "pragma page_count") * pragmaInt(db, "pragma page_size");
+        if (best == 0 || bytes < bestBytes)
+        {
+            best = size;
+            bestBytes = bytes;
+        }
+    }
+    std::string sql = "pragma page_size = " + std::to_string(best);
+    exec(db, sql.c_str());
+    exec(db, "vacuum");
+    return best;
+}
+
+// Fails unless each app query plans as index searches or index walks. A plain
+// "SCAN newmorphs" reads every row of the table, and "USE TEMP B-TREE" sorts at
+// run time, when an index could have given the order.
+void checkPlans(sqlite3 *db)
+{
+    for (const char *sql : gwr::gkqz::DbQueries::all)
+    {
+        std::string explain = std::string{"explain query plan "} + sql;
+        sqlite3_stmt *st{nullptr};
+        if (sqlite3_prepare_v2(db, explain.c_str(), -1, &st, nullptr) != SQLITE_OK)
+            fail(db, sql);
+        int rc;
+        while ((rc = sqlite3_step(st)) == SQLITE_ROW)
+        {
+            std::string_view detail{reinterpret_cast<const char *>(sqlite3_column_text(st, 3))};
+            bool scan = detail.starts_with("SCAN") && detail.find(" INDEX ") == detail.npos;
+            if (scan || detail.find("TEMP B-TREE") != detail.npos)
+            {
+                std::fprintf(stderr, "gkqz-dbbuild: no index serves\n  %s\n  plan: %.*s\n", sql,
+                             (int)detail.size(), detail.data());
+                std::exit(1);
+            }
+        }
+        if (rc != SQLITE_DONE)
+            fail(db, sql);
+        sqlite3_finalize(st);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Accents accents{Accents::Oxia};
+    if (argc == 4 && std::string{argv[1]} == "--tonos")
+    {
+        accents = Accents::Tonos;
+        --argc;
+        ++argv;
+    }
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: gkqz-dbbuild [--tonos] <authoring.sqlite3> <out.db>\n");
+        return 2;
+    }
+    std::string src{argv[1]}, out{argv[2]}, tmp{out + ".tmp"};
+    std::remove(tmp.c_str());
+
+    sqlite3 *db{nullptr};
+    if (sqlite3_open(tmp.c_str(), &db) != SQLITE_OK)
+        fail(db, "open");
+
+    std::string attach = "attach database '" + src + "' as src";
+    exec(db, attach.c_str());
+    exec(db, "begin");
+
+    // the display forms are stored precomputed, so the app never transcodes db text
+    // the app never writes, so no AUTOINCREMENT (and no sqlite_sequence table)
+    exec(db, "create table `newmorphs` ("
+             "`id` INTEGER PRIMARY KEY,"
+             "`inflected` TEXT,"
+             "`head` TEXT,"
+             "`parse` TEXT,"
+             "`lesson` INT,"
+             "`inflected_gk` TEXT,"
+             "`head_gk` TEXT)");
+    copyRows(db, accents);
+
+    // rows by lesson and by form are indexed, and nothing else is; gkqz.img
+    // carries the same two lookups. An index entry ends in the rowid, so (lesson)
+    // alone covers "order by lesson, id".
+    exec(db, "create index newmorphs_lesson on newmorphs (lesson)");
+    exec(db, "create index newmorphs_inflected on newmorphs (inflected)");
+
+    exec(db, "commit");
+    exec(db, "detach database src");
+    exec(db, "analyze");
+    int pageSize = compact(db);
+    checkPlans(db);
+    auto bytes = pragmaInt(db, "pragma page_count") * pageSize;
+    sqlite3_close(db);
+
+    if (std::rename(tmp.c_str(), out.c_str()) != 0)
+    {
+        std::perror("gkqz-dbbuild: rename");
+        return 1;
+    }
+    std::printf("%s: %lld bytes, page size %d\n", out.c_str(), (long long)bytes, pageSize);
+    return 0;
+}
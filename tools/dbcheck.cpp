@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+
+// Checks that gkqz.db and gkqz.img hold the same quiz, reading the db the way
+// the app would, through DbManager and QuizSampler's SQL constructor:
+//
+//   gkqz-dbcheck dbs/gkqz.db dbs/gkqz.img
+//
+// Every row of the image is fetched by id with DbQueries::kById and every
+// form's rows with kByForm, and each must match MorphStore field for field.
+// The two QuizSamplers must offer the same ids for every lesson, which also
+// catches a row only the db has. Exits 1 and prints the first few differences.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "DbManager.h"
+#include "DbQueries.h"
+#include "MorphImage.h"
+#include "MorphStore.h"
+#include "QuizSampler.h"
+
+using namespace gwr::gkqz;
+
+namespace
+{
+
+long failures{0};
+
+void report(const char *what, int n)
+{
+    if (++failures <= 5)
+        std::printf("%s %d differs\n", what, n);
+}
+
+std::string readFile(const char *path)
+{
+    std::ifstream in{path, std::ios::binary};
+    std::string bytes{std::istreambuf_iterator<char>{in}, {}};
+    if (!in && !in.eof())
+    {
+        std::fprintf(stderr, "gkqz-dbcheck: cannot read %s\n", path);
+        std::exit(1);
+    }
+    return bytes;
+}
+
+bool same(const dbEntry &a, const dbEntry &b)
+{
+    return a.id == b.id && a.lesson == b.lesson && a.head == b.head &&
+           a.inflected == b.inflected && a.parse == b.parse && a.headGk == b.headGk &&
+           a.inflectedGk == b.inflectedGk && a.parseMask == b.parseMask;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: gkqz-dbcheck <gkqz.db> <gkqz.img>\n");
+        return 2;
+    }
+    std::string db = readFile(argv[1]), image = readFile(argv[2]);
+    try
+    {
+        DbManager dbm{db.data(), db.size(), ":memory:"};
+        MorphStore morphs{MorphImage{image.data(), image.size()}};
+
+        std::vector<dbEntry> rows;
+        size_t forms{0};
+        for (uint32_t row = 0; row < morphs.size(); ++row)
+        {
+            dbEntry want = morphs.entry(row);
+            if (dbm.query(DbQueries::kById, rows, want.id) != 1 || !same(rows[0], want))
+                report("row with id", want.id);
+
+            // each form once, at its first row
+            auto alts = morphs.rowsWithForm(want.inflected);
+            if (alts.empty() || morphs.entry(alts[0]).id != want.id)
+                continue;
+            ++forms;
+            dbm.query(DbQueries::kByForm, rows, std::string{want.inflected.view()});
+            bool match = rows.size() == alts.size();
+            for (size_t i = 0; match && i < alts.size(); ++i)
+                match = same(rows[i], morphs.entry(alts[i]));
+            if (!match)
+                report("rows with the form of id", want.id);
+        }
+
+        QuizSampler fromDb{dbm.db}, fromImage{morphs};
+        for (int lesson = 0; lesson <= morphs.lessonCount(); ++lesson)
+        {
+            auto a = fromDb.sample(lesson, morphs.size()), b = fromImage.sample(lesson, morphs.size());
+            std::sort(a.begin(), a.end());
+            std::sort(b.begin(), b.end());
+            if (a != b)
+                report("QuizSampler ids up to lesson", lesson);
+        }
+        std::printf("%zu rows, %zu forms and %d lessons, %ld differences\n", morphs.size(), forms,
+                    morphs.lessonCount(), failures);
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "gkqz-dbcheck: %s\n", e.what());
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
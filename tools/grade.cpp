@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+// Grades class submissions offline, stdin to stdout.
+//
+//   gkqz-grade [-j threads] [-l] dbs/gkqz.img < answers.tsv > results.jsonl
+//
+// Each input line is one answer, tab-separated:
+//
+//   student  newmorphs-id  headword-in-Betacode  parse
+//
+// and consecutive lines for the same student make up one submission; a
+// student's lines must all be together, and one that turns up again after
+// another student's is an error. Each submission comes out as one JSON line,
+// in input order:
+//
+//   {"student":"ann","right":1,"items":[{"id":292,"head":true,"parse":true,"match":292}]}
+//
+// where right counts items with both head and parse right, match is the id of
+// the row the answer names (0 if none), and an id that is not in the image gets
+// "known":false. Headwords are marked with accents unless -l asks for the
+// letters alone; one over HeadKey::kMaxHead bytes is not marked at all, and its
+// item gets "headTooLong":true. Parse words that are no feature in any spelling are listed as
+// "unknown":["aorr"], so a teacher can see a typo. Input is graded a block at a
+// time on the same worker threads throughout, so memory stays bounded.
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "BatchGrader.h"
+#include "ParseMask.h"
+
+using namespace gwr::gkqz;
+
+namespace
+{
+
+constexpr size_t kBlockItems = 1 << 18;
+
+void fail(const char *what, const std::string &detail)
+{
+    std::fprintf(stderr, "gkqz-grade: %s: %s\n", what, detail.c_str());
+    std::exit(1);
+}
+
+void appendJson(std::string &out, std::string_view s)
+{
+    out += '"';
+    for (unsigned char c : s)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (c < 0x20)
+        {
+            char esc[8];
+            std::snprintf(esc, sizeof esc, "\\u%04x", c);
+            out += esc;
+        }
+        else
+            out += (char)c;
+    }
+    out += '"';
+}
+
+void writeBlock(std::span<const Submission> subs, std::span<const ItemResult> results)
+{
+    std::string out;
+    const ItemResult *r = results.data();
+    for (auto &s : subs)
+    {
+        int right{0};
+        for (size_t i = 0; i < s.items.size(); ++i)
+            right += r[i].head && r[i].parse;
+        out += "{\"student\":";
+        appendJson(out, s.student);
+        out += ",\"right\":" + std::to_string(right) + ",\"items\":[";
+        for (size_t i = 0; i < s.items.size(); ++i, ++r)
+        {
+            out += i ? ",{\"id\":" : "{\"id\":";
+            out += std::to_string(s.items[i].id);
+            if (!r->known)
+                out += ",\"known\":false";
+            if (r->headTooLong)
+                out += ",\"headTooLong\":true";
+            out += r->head ? ",\"head\":true" : ",\"head\":false";
+            out += r->parse ? ",\"parse\":true" : ",\"parse\":false";
+            out += ",\"match\":" + std::to_string(r->match);
+            bool first{true};
+            ParseMask::compile(s.items[i].parse, [&](std::string_view token) {
+                out += first ? ",\"unknown\":[" : ",";
+                appendJson(out, token);
+                first = false;
+            });
+            out += first ? "}" : "]}";
+        }
+        out += "]}\n";
+    }
+    if (std::fwrite(out.data(), 1, out.size(), stdout) != out.size())
+        fail("write", "stdout");
+}
+
+// splits "a\tb\tc\td" into four fields; false if there are not exactly four
+bool fields(std::string_view line, std::string_view (&f)[4])
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        size_t tab = line.find('\t');
+        if (tab == std::string_view::npos)
+            return false;
+        f[i] = line.substr(0, tab);
+        line.remove_prefix(tab + 1);
+    }
+    f[3] = line;
+    return f[3].find('\t') == std::string_view::npos;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    unsigned threads{0};
+    HeadMatch match{HeadMatch::Accents};
+    while (argc >= 2)
+    {
+        std::string_view opt{argv[1]};
+        int used{0};
+        if (opt == "-j" && argc >= 3)
+        {
+            threads = (unsigned)std::atoi(argv[2]);
+            used = 2;
+        }
+        else if (opt == "-l")
+        {
+            match = HeadMatch::Letters;
+            used = 1;
+        }
+        else
+            break;
+        argc -= used;
+        argv += used;
+    }
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: gkqz-grade [-j threads] [-l] <gkqz.img> < answers.tsv\n");
+        return 2;
+    }
+    std::ifstream in{argv[1], std::ios::binary};
+    std::string image{std::istreambuf_iterator<char>{in}, {}};
+    if (!in && !in.eof())
+        fail("read", argv[1]);
+    std::optional<MorphStore> morphs;
+    std::optional<Grader> grader;
+    try
+    {
+        morphs.emplace(MorphImage{image.data(), image.size()});
+        grader.emplace(*morphs);
+    }
+    catch (const std::exception &e)
+    {
+        fail("image", e.what());
+    }
+
+    BatchGrader batch{*grader, threads, match};
+    std::vector<Submission> subs;
+    std::vector<ItemResult> results;
+    std::unordered_set<std::string> finished; // students whose lines have ended
+    size_t items{0}, lineNo{0};
+    auto flush = [&](size_t count) { // grades and writes the first count submissions
+        std::span<const Submission> block{subs.data(), count};
+        results.resize(itemCount(block));
+        batch.grade(block, results);
+        writeBlock(block, results);
+    };
+
+    std::ios::sync_with_stdio(false);
+    std::string text;
+    while (std::getline(std::cin, text))
+    {
+        ++lineNo;
+        std::string_view line{text};
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+        std::string_view f[4];
+        int id{0};
+        if (!fields(line, f))
+            fail("expected 4 tab-separated fields on line", std::to_string(lineNo));
+        const char *idEnd = f[1].data() + f[1].size();
+        if (auto [ptr, ec] = std::from_chars(f[1].data(), idEnd, id);
+            ec != std::errc{} || ptr != idEnd)
+            fail("bad id on line", std::to_string(lineNo));
+
+        if (subs.empty() || subs.back().student != f[0])
+        {
+            if (!subs.empty())
+                finished.insert(subs.back().student);
+            if (finished.contains(std::string{f[0]}))
+                fail("lines for one student are not together; again on line",
+                     std::to_string(lineNo));
+            // a block ends between submissions, so none is split across two
+            if (items >= kBlockItems)
+            {
+                flush(subs.size());
+                subs.clear();
+                items = 0;
+            }
+            subs.push_back({std::string{f[0]}, {}});
+        }
+        subs.back().items.push_back({id, std::string{f[2]}, std::string{f[3]}});
+        ++items;
+    }
+    flush(subs.size());
+    return 0;
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+// Flattens the embedded quiz database into the image MorphImage reads.
+//
+//   gkqz-imgbuild dbs/gkqz.db dbs/gkqz.img
+//
+// Run it after gkqz-dbbuild and commit both outputs. The app quizzes from
+// gkqz.img alone, so it can be built without sqlite (GKQZ_WITH_SQLITE=OFF);
+// sqlite stays the authoring format. CMake checks the result against
+// GKQZ_IMG_BUDGET.
+
+#include <sqlite3.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MorphImage.h"
+#include "ParseMask.h"
+
+using gwr::gkqz::MorphImage;
+using gwr::gkqz::ParseMask;
+
+namespace
+{
+
+void fail(const char *what, const std::string &detail)
+{
+    std::fprintf(stderr, "gkqz-imgbuild: %s: %s\n", what, detail.c_str());
+    std::exit(1);
+}
+
+// each distinct string once, length byte first
+struct Pool
+{
+    std::string bytes;
+    std::unordered_map<std::string, uint32_t> offsets;
+
+    uint32_t add(const std::string &s)
+    {
+        if (s.size() > 255)
+            fail("string longer than 255 bytes", s);
+        auto [it, added] = offsets.try_emplace(s, (uint32_t)bytes.size());
+        if (added)
+        {
+            bytes += (char)s.size();
+            bytes += s;
+        }
+        return it->second;
+    }
+};
+
+std::string text(sqlite3_stmt *st, int col)
+{
+    auto p = reinterpret_cast<const char *>(sqlite3_column_text(st, col));
+    return p ? std::string{p, (size_t)sqlite3_column_bytes(st, col)} : std::string{};
+}
+
+template <typename T> void append(std::string &out, const std::vector<T> &v)
+{
+    out.append(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(T));
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: gkqz-imgbuild <gkqz.db> <out.img>\n");
+        return 2;
+    }
+    sqlite3 *db{nullptr};
+    if (sqlite3_open_v2(argv[1], &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
+        fail("open", sqlite3_errmsg(db));
+    sqlite3_stmt *st{nullptr};
+    if (sqlite3_prepare_v2(db,
+                           "select id, lesson, inflected, head, parse, inflected_gk, head_gk "
+                           "from newmorphs order by lesson, id",
+                           -1, &st, nullptr) != SQLITE_OK)
+        fail("query", sqlite3_errmsg(db));
+
+    Pool pool;
+    std::vector<MorphImage::Row> rows;
+    while (sqlite3_step(st) == SQLITE_ROW)
+    {
+        int id = sqlite3_column_int(st, 0), lesson = sqlite3_column_int(st, 1);
+        if (id < 0 || lesson < 0)
+            fail("negative id or lesson", std::to_string(id));
+        std::string inflected = text(st, 2), parse = text(st, 4);
+        // grading compiles parses to ParseMask; a token it doesn't know could never be matched
+        if (!ParseMask::compile(parse).known())
+            fail("parse has a token missing from ParseMask::kFeatures", parse);
+        rows.push_back({(uint32_t)id, (uint32_t)lesson, pool.add(inflected), pool.add(text(st, 3)),
+                        pool.add(parse), pool.add(text(st, 5)), pool.add(text(st, 6))});
+    }
+    sqlite3_finalize(st);
+    sqlite3_close(db);
+    if (rows.empty())
+        fail("no rows in", argv[1]);
+
+    MorphImage::Header h{};
+    std::memcpy(h.magic, MorphImage::kMagic, sizeof(h.magic));
+    h.rowCount = (uint32_t)rows.size();
+
+    // rows are in (lesson, id) order, so each lesson is one run of them
+    std::vector<uint32_t> lessons;
+    for (uint32_t i = 0; i < h.rowCount; ++i)
+        while (lessons.size() <= rows[i].lesson)
+            lessons.push_back(i);
+    lessons.push_back(h.rowCount);
+    h.lessonCount = (uint32_t)lessons.size() - 1;
+
+    // MorphStore maps ids to rows itself, but needs them unique
+    std::vector<uint32_t> ids;
+    for (auto &r : rows)
+        ids.push_back(r.id);
+    std::sort(ids.begin(), ids.end());
+    if (auto dup = std::adjacent_find(ids.begin(), ids.end()); dup != ids.end())
+        fail("duplicate id", std::to_string(*dup));
+
+    h.poolSize = (uint32_t)pool.bytes.size();
+    h.rows = sizeof(h);
+    h.lessons = h.rows + h.rowCount * sizeof(MorphImage::Row);
+    h.pool = h.lessons + (h.lessonCount + 1) * 4;
+
+    std::string out{reinterpret_cast<const char *>(&h), sizeof(h)};
+    append(out, rows);
+    append(out, lessons);
+    out += pool.bytes;
+    MorphImage check{out.data(), out.size()}; // throws if this tool wrote nonsense
+
+    std::string tmp = std::string{argv[2]} + ".tmp";
+    FILE *f = std::fopen(tmp.c_str(), "wb");
+    if (!f || std::fwrite(out.data(), 1, out.size(), f) != out.size() || std::fclose(f) != 0)
+        fail("write", tmp);
+    if (std::rename(tmp.c_str(), argv[2]) != 0)
+        fail("rename", tmp);
+    std::printf("%s: %zu bytes, %u rows, %u pool bytes\n", argv[2], out.size(), h.rowCount,
+                h.poolSize);
+    return 0;
+}
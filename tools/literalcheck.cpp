@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+
+// Checks that "_gk" literals come out exactly as Betacode::beta2greek writes
+// them at runtime: a table of literals converted at compile time, in both
+// accent modes, then BetacodeLiteral::beta2greek itself on every string of up
+// to kExhaustiveLength bytes over kAlphabet. Exits 1 and prints the first few
+// inputs that differ.
+//
+//   gkqz-literalcheck
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include "Betacode.h"
+#include "BetacodeLiteral.h"
+
+namespace
+{
+
+constexpr std::string_view kAlphabet{"abgswAS*)(/\\=+|12 ,.;:\"'-_#"};
+constexpr int kExhaustiveLength{4};
+
+long failures{0};
+
+void compare(std::string_view what, std::string_view beta, std::string_view literal,
+             Accents accents)
+{
+    if (literal == Betacode::beta2greek(std::string{beta}, accents) || ++failures > 5)
+        return;
+    std::printf("%.*s differs on \"%.*s\" (%s)\n", (int)what.size(), what.data(),
+                (int)beta.size(), beta.data(), accents == Accents::Oxia ? "oxia" : "tonos");
+}
+
+template <BetacodeString... B> long checkLiterals()
+{
+    (compare("_gk", B.view(), greekString<B, Accents::Oxia>.view(), Accents::Oxia), ...);
+    (compare("greekString", B.view(), greekString<B, Accents::Tonos>.view(), Accents::Tonos),
+     ...);
+    return sizeof...(B);
+}
+
+} // namespace
+
+int main()
+{
+    // capitals, breathings, every accent, iota subscript, diaeresis, the
+    // sigma forms, quotes and punctuation
+    long literals = checkLiterals<"lo/gos", "*)/anqrwpos", "ba/rbaros", "tw=|", "pai+/s",
+                                  "\"ei)=pen\"", "*(/ellhnes", "a)/gw", "a/)gw", "h(=|",
+                                  "e)stin; ou)k oi)=da.", "s1s2s", "lu/w, lu/eis", "*w)=|dh/",
+                                  "mou+sa", "qeoi=s", "*)aqh=nai", "bou=s:">();
+
+    long exhaustive{0};
+    std::string s;
+    char utf8[Betacode::greekCapacity(kExhaustiveLength)];
+    for (int length = 1; length <= kExhaustiveLength; ++length)
+    {
+        // s counts through every string of this length, as digits in base kAlphabet.size()
+        std::string digits(length, 0);
+        for (;;)
+        {
+            s.resize(length);
+            for (int i = 0; i < length; ++i)
+                s[i] = kAlphabet[(unsigned char)digits[i]];
+            compare("BetacodeLiteral", s, {utf8, BetacodeLiteral::beta2greek(s, utf8)},
+                    Accents::Oxia);
+            compare("BetacodeLiteral", s,
+                    {utf8, BetacodeLiteral::beta2greek<Accents::Tonos>(s, utf8)},
+                    Accents::Tonos);
+            ++exhaustive;
+            int i = length - 1;
+            while (i >= 0 && ++digits[i] == (char)kAlphabet.size())
+                digits[i--] = 0;
+            if (i < 0)
+                break;
+        }
+    }
+
+    std::printf("%ld literals and %ld exhaustive inputs, %ld differences\n", literals, exhaustive,
+                failures);
+    return failures == 0 ? 0 : 1;
+}
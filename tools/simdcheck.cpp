@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////// 
+//                                                                      // 
+// Greek Quiz - a suite of apps for practicing Ancient Greek.           // 
+//                                                                      // 
+// Copyright 2025, Greg Recco                                           // 
+//                                                                      // 
+// Greek Quiz is released under the GNU General Public Licence v3       // 
+// or later (GPL-3.0-or-later). The license is found in the 'LICENSE'   // 
+// file in the root of this repository, or at                           // 
+// https://www.gnu.org/licenses/gpl-3.0.en.html                         // 
+//                                                                      // 
+// The source code repository for Greek Quiz is available at            // 
+// https://github.com/Quizyes/GreekQuiz                                 // 
+//                                                                      // 
+////////////////////////////////////////////////////////////////////////// 
+
+
+// Checks that the vector fast paths in libs/unibetacode/ub_simd.c change no
+// output: converts the same input with this build and with one compiled with
+// UB_SCALAR_ONLY (simdcheck_scalar.c) and compares them byte for byte.
+//
+//   gkqz-simdcheck [random-count]
+//
+// Every string of up to kExhaustiveLength bytes over kAlphabet is tried, then
+// random-count (default 1M) longer strings from a fixed seed, long enough for
+// the 16-byte blocks and with small output buffers mixed in. Exits 1 and
+// prints the first few inputs that differ.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+extern "C"
+{
+    int ub_beta2greek_r(const char *beta, int max_beta, char *utf8gk, int max_utf8,
+                        int *quote_state, int accents);
+    int ub_ascii_span(const unsigned char *utf8, int max_utf8);
+    int scalar_ub_beta2greek_r(const char *beta, int max_beta, char *utf8gk, int max_utf8,
+                               int *quote_state, int accents);
+    int scalar_ub_ascii_span(const unsigned char *utf8, int max_utf8);
+}
+
+namespace
+{
+
+// plain letters, sigma forms, capitals, every combining mark, quotes,
+// punctuation and the lead bytes of Greek UTF-8
+constexpr std::string_view kAlphabet{"abgswAS*)(/\\=+|123 ,.;:\"'-_#\t\xce\xcf\x80"};
+constexpr int kExhaustiveLength{4};
+constexpr int kMaxRandomLength{80};
+
+long failures{0};
+
+void report(std::string_view what, std::string_view input)
+{
+    if (++failures > 5)
+        return;
+    std::printf("%.*s differs on \"", (int)what.size(), what.data());
+    for (unsigned char c : input)
+        std::printf(c >= 0x20 && c < 0x7f && c != '"' && c != '\\' ? "%c" : "\\x%02x", c);
+    std::printf("\"\n");
+}
+
+// maxUtf8 below the worst case exercises the fast path's clamp to the buffer
+void compare(std::string_view input, int maxUtf8)
+{
+    char fast[3 * kMaxRandomLength + 1], slow[3 * kMaxRandomLength + 1];
+    for (int accents = 0; accents < 2; ++accents)
+    {
+        for (int quote = 0; quote < 2; ++quote)
+        {
+            int fastQuote{quote}, slowQuote{quote};
+            std::memset(fast, 0x55, sizeof fast);
+            std::memset(slow, 0x55, sizeof slow);
+            int fastLength = ub_beta2greek_r(input.data(), (int)input.size(), fast, maxUtf8,
+                                             &fastQuote, accents);
+            int slowLength = scalar_ub_beta2greek_r(input.data(), (int)input.size(), slow,
+                                                    maxUtf8, &slowQuote, accents);
+            if (fastLength != slowLength || fastQuote != slowQuote ||
+                std::memcmp(fast, slow, sizeof fast) != 0)
+                return report("ub_beta2greek_r", input);
+        }
+    }
+    auto bytes = reinterpret_cast<const unsigned char *>(input.data());
+    if (ub_ascii_span(bytes, (int)input.size()) != scalar_ub_ascii_span(bytes, (int)input.size()))
+        report("ub_ascii_span", input);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    long randomCount = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    long exhaustive{0};
+    std::string s;
+    for (int length = 1; length <= kExhaustiveLength; ++length)
+    {
+        // s counts through every string of this length, as digits in base kAlphabet.size()
+        std::string digits(length, 0);
+        for (;;)
+        {
+            s.resize(length);
+            for (int i = 0; i < length; ++i)
+                s[i] = kAlphabet[(unsigned char)digits[i]];
+            compare(s, 3 * length + 1);
+            ++exhaustive;
+            int i = length - 1;
+            while (i >= 0 && ++digits[i] == (char)kAlphabet.size())
+                digits[i--] = 0;
+            if (i < 0)
+                break;
+        }
+    }
+
+    // mostly plain letters, so there are long runs for the vector code to take
+    constexpr std::string_view kPlain{"abgdehiklmnoprtuwxyz ,."};
+    std::mt19937 rng{20250101};
+    for (long n = 0; n < randomCount; ++n)
+    {
+        int length = 1 + (int)(rng() % kMaxRandomLength);
+        s.resize(length);
+        for (auto &c : s)
+            c = rng() % 4 ? kPlain[rng() % kPlain.size()] : kAlphabet[rng() % kAlphabet.size()];
+        compare(s, rng() % 8 ? 3 * length + 1 : 1 + (int)(rng() % (3 * length + 1)));
+    }
+
+    std::printf("%ld exhaustive and %ld random inputs, %ld differences\n", exhaustive, randomCount,
+                failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+/*
+   simdcheck_scalar.c - the unibetacode converters built with
+                        UB_SCALAR_ONLY, under a scalar_ prefix, so that
+                        gkqz-simdcheck can link them next to the vector
+                        build and compare the two.
+
+   LICENSE:
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 2 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define UB_SCALAR_ONLY
+
+/* every external symbol of the two files below */
+#define ascii2greek          scalar_ascii2greek
+#define beta2combining       scalar_beta2combining
+#define beta2combining_alt   scalar_beta2combining_alt
+#define greek_comb2uni       scalar_greek_comb2uni
+#define ub_beta2greek        scalar_ub_beta2greek
+#define ub_beta2greek_r      scalar_ub_beta2greek_r
+#define ub_beta2greek_step   scalar_ub_beta2greek_step
+#define ub_greek_char2utf8   scalar_ub_greek_char2utf8
+#define ub_greek_comb2flag   scalar_ub_greek_comb2flag
+#define ub_greek_poly2utf8   scalar_ub_greek_poly2utf8
+#define ub_greek_scanchar    scalar_ub_greek_scanchar
+#define ub_beta_plain_span   scalar_ub_beta_plain_span
+#define ub_ascii_span        scalar_ub_ascii_span
+
+#include "ub_beta2greek.c"
+#include "ub_simd.c"